@@ -0,0 +1,242 @@
+//----------------------------------------------------------------------
+//--
+//--    backtrackEngine.cpp
+//--
+//--        Implementation of backtrackEngine object - Reference engine :
+//--        depth-first search with backtracking
+//--
+//----------------------------------------------------------------------
+
+#include "backtrackEngine.h"
+
+// Construction
+//
+//  @mode : search mode
+//
+backtrackEngine::backtrackEngine(uint8_t mode){
+    mode_ = mode;
+    depth_ = -1;
+    valid_ = false;
+}
+
+// name() : Name of the engine
+//
+//  @return : the name
+//
+const char* backtrackEngine::name(){
+    return ((SEARCH_MODE_LINEAR == mode_)?"linear":
+            ((SEARCH_MODE_MRV == mode_)?"mrv":"propagate"));
+}
+
+// solve() : Find a solution for a board
+//
+//  @values : values of the board. Will receive the values
+//          of the solution if one is found
+//
+//  @return : true if a solution was found
+//
+bool backtrackEngine::solve(uint8_t* values){
+    start(values);
+    return next(values);
+}
+
+// countSolutions() : Count the solutions of a board
+//
+//  @values : values of the board
+//  @limit : max. # of solutions to search for
+//
+//  @return : # of solutions found (at most @limit)
+//
+uint8_t backtrackEngine::countSolutions(const uint8_t* values, uint8_t limit){
+    uint8_t count(0);
+    start(values);
+    while (count < limit && next()){
+        count++;
+    }
+
+    if (budget_){
+        budget_->solutions = count;
+    }
+
+    return count;
+}
+
+// propagate() : Set the obvious values of a board until none
+//              can be found
+//
+//  An obvious value is either the only candidate of a position or
+//  a value that can only be put at one position of a unit
+//
+//  @values : values of the board. Will receive the obvious values
+//
+//  @return : # of obvious values set or -1 if the board
+//            can't be solved
+//
+int8_t backtrackEngine::propagate(uint8_t* values){
+    nodes_ = 0;
+    board_.setBudget(budget_);
+    return (int8_t)board_.propagate(values);
+}
+
+// start() : Start a search through the solutions of a board
+//
+//  @values : values of the board
+//
+void backtrackEngine::start(const uint8_t* values){
+    nodes_ = 0;
+    if (SEARCH_MODE_PROPAGATE == mode_){
+        board_.setBudget(budget_);
+        board_.start(values);
+        return;
+    }
+
+    depth_ = -1;
+    valid_ = _load(values);
+}
+
+// next() : Search for the next solution
+//
+//  @solution : table that will receive the values of the solution.
+//          Can be NULL
+//
+//  @return : true if a new solution has been found
+//
+bool backtrackEngine::next(uint8_t* solution){
+    if (SEARCH_MODE_PROPAGATE == mode_){
+        board_.setBudget(budget_);
+        bool found(board_.next(solution));
+        nodes_ = board_.nodes();
+        return found;
+    }
+
+    uint8_t pos;
+    uint16_t candidates;
+    while (true){
+        if (valid_){
+            if (!_nextPos(pos, candidates)){
+                // No more empty position => a new solution
+                if (solution){
+                    memcpy(solution, values_, VALUES_COUNT);
+                }
+
+                valid_ = false;     // Next call will search for another
+                return true;
+            }
+
+            if (!candidates){
+                valid_ = false;     // Dead end
+                continue;
+            }
+
+            // A new position in the stack
+            positions_[++depth_] = pos;
+            untried_[depth_] = candidates;
+        }
+        else{
+            // Go back to the last position with candidates left
+            while (depth_ >= 0 && !untried_[depth_]){
+                _emptyValue(positions_[depth_--]);
+            }
+
+            if (depth_ < 0){
+                return false;   // All candidates have been tried
+            }
+
+            // Remove the previous try
+            _emptyValue(positions_[depth_]);
+        }
+
+        // Try the smallest untried candidate
+        candidates = untried_[depth_];
+        untried_[depth_] &= (candidates - 1);
+        _setValue(positions_[depth_], VALUE_MIN + __builtin_ctz(candidates));
+        nodes_++;
+        if (_overBudget()){
+            // Stop here
+            valid_ = false;
+            depth_ = -1;
+            return false;
+        }
+
+        valid_ = true;
+    }
+}
+
+//
+// Internal methods
+//
+
+// _load() : Copy the values of a board and build the masks
+//
+//  @values : values of the board
+//
+//  @return : false if a value is used twice in a unit
+//
+bool backtrackEngine::_load(const uint8_t* values){
+    memset(lineMasks_, 0, sizeof(lineMasks_));
+    memset(rowMasks_, 0, sizeof(rowMasks_));
+    memset(squareMasks_, 0, sizeof(squareMasks_));
+
+    bool valid(true);
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        if (EMPTY_VALUE == (values_[index] = values[index])){
+            continue;
+        }
+
+        if (_candidates(index) & VALUE_BIT(values[index])){
+            _setValue(index, values[index]);
+        }
+        else{
+            valid = false;  // Already in the line, the row or the square
+        }
+    }
+
+    return valid;
+}
+
+// _nextPos() : Find the next empty position to fill
+//
+//  @pos : will receive the index of the found position
+//  @candidates : will receive the candidates of @pos
+//
+//  @return : false if there is no more empty position
+//
+bool backtrackEngine::_nextPos(uint8_t& pos, uint16_t& candidates){
+    uint8_t index;
+    if (SEARCH_MODE_LINEAR == mode_){
+        // The first empty position after the last one filled
+        for (index = ((depth_ < 0)?INDEX_MIN:(positions_[depth_] + 1));
+            index <= INDEX_MAX; index++){
+            if (EMPTY_VALUE == values_[index]){
+                pos = index;
+                candidates = _candidates(index);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // The empty position with the fewest candidates
+    uint8_t count, minCount(VALUE_MAX + 1);
+    uint16_t values;
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        if (EMPTY_VALUE == values_[index]){
+            values = _candidates(index);
+            if ((count = __builtin_popcount(values)) < minCount){
+                pos = index;
+                candidates = values;
+                minCount = count;
+
+                if (count <= 1){
+                    // Can't find a "better" position
+                    return true;
+                }
+            }
+        }
+    }
+
+    return (minCount <= VALUE_MAX);
+}
+
+// EOF
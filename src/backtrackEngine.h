@@ -0,0 +1,190 @@
+//----------------------------------------------------------------------
+//--
+//--    backtrackEngine.h
+//--
+//--        Definition of backtrackEngine object - Reference engine :
+//--        depth-first search with backtracking
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_BACKTRACK_ENGINE_h__
+#define __S_SOLVER_BACKTRACK_ENGINE_h__    1
+
+#include "solverEngine.h"
+#include "gridTables.h"
+#include "boardSolver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+//   backtrackEngine : Depth-first search with backtracking
+//
+//      The search puts a value at an empty position, and goes back to
+//      the last position with untried candidates when a position has
+//      no candidate left. Depending on the mode :
+//          - SEARCH_MODE_LINEAR : empty positions are filled in
+//            index order;
+//          - SEARCH_MODE_MRV : the empty position with the fewest
+//            candidates is filled first;
+//          - SEARCH_MODE_PROPAGATE : like SEARCH_MODE_MRV, but after
+//            each value tried, all the obvious values are set until
+//            none can be found. The search is done by
+//            boardSolver<GEOMETRY_9>.
+//
+//      Obvious values are always found by boardSolver<GEOMETRY_9>.
+//
+//      The search is resumable : start() then next() for each solution.
+//
+class backtrackEngine : public solverEngine{
+public:
+
+    // Construction
+    //
+    //  @mode : search mode
+    //
+    backtrackEngine(uint8_t mode = SEARCH_MODE_PROPAGATE);
+    backtrackEngine(const backtrackEngine&) = delete;
+
+    // Destruction
+    ~backtrackEngine(){}
+
+    // name() : Name of the engine
+    //
+    //  @return : the name
+    //
+    const char* name();
+
+    // solve() : Find a solution for a board
+    //
+    //  @values : values of the board. Will receive the values
+    //          of the solution if one is found
+    //
+    //  @return : true if a solution was found
+    //
+    bool solve(uint8_t* values);
+
+    // countSolutions() : Count the solutions of a board
+    //
+    //  @values : values of the board
+    //  @limit : max. # of solutions to search for
+    //
+    //  @return : # of solutions found (at most @limit)
+    //
+    uint8_t countSolutions(const uint8_t* values, uint8_t limit);
+
+    // propagate() : Set the obvious values of a board until none
+    //              can be found
+    //
+    //  An obvious value is either the only candidate of a position or
+    //  a value that can only be put at one position of a unit
+    //
+    //  @values : values of the board. Will receive the obvious values
+    //
+    //  @return : # of obvious values set or -1 if the board
+    //            can't be solved
+    //
+    int8_t propagate(uint8_t* values);
+
+    //
+    // Resumable search
+    //
+
+    // start() : Start a search through the solutions of a board
+    //
+    //  @values : values of the board
+    //
+    void start(const uint8_t* values);
+
+    // next() : Search for the next solution
+    //
+    //  @solution : table that will receive the values of the solution.
+    //          Can be NULL
+    //
+    //  @return : true if a new solution has been found
+    //
+    bool next(uint8_t* solution = NULL);
+
+private:
+
+    // _load() : Copy the values of a board and build the masks
+    //
+    //  @values : values of the board
+    //
+    //  @return : false if a value is used twice in a unit
+    //
+    bool _load(const uint8_t* values);
+
+    // _setValue() : Put a value at an empty position
+    //
+    //  @index : index of the position
+    //  @value : value
+    //
+    void _setValue(uint8_t index, uint8_t value){
+        uint16_t bit(VALUE_BIT(value));
+        values_[index] = value;
+        lineMasks_[gGridTables.line[index]] |= bit;
+        rowMasks_[gGridTables.row[index]] |= bit;
+        squareMasks_[gGridTables.square[index]] |= bit;
+    }
+
+    // _emptyValue() : Empty a position
+    //
+    //  @index : index of the position
+    //
+    void _emptyValue(uint8_t index){
+        uint16_t bit(~VALUE_BIT(values_[index]));
+        values_[index] = EMPTY_VALUE;
+        lineMasks_[gGridTables.line[index]] &= bit;
+        rowMasks_[gGridTables.row[index]] &= bit;
+        squareMasks_[gGridTables.square[index]] &= bit;
+    }
+
+    // _candidates() : Values that can be put at a position
+    //
+    //  @index : index of the position
+    //
+    //  @return : mask of allowed values
+    //
+    uint16_t _candidates(uint8_t index){
+        return (ALL_VALUES_MASK & ~(lineMasks_[gGridTables.line[index]]
+                | rowMasks_[gGridTables.row[index]]
+                | squareMasks_[gGridTables.square[index]]));
+    }
+
+    // _nextPos() : Find the next empty position to fill
+    //
+    //  @pos : will receive the index of the found position
+    //  @candidates : will receive the candidates of @pos
+    //
+    //  @return : false if there is no more empty position
+    //
+    bool _nextPos(uint8_t& pos, uint16_t& candidates);
+
+    // Members
+private:
+    uint8_t mode_;                  // Search mode
+
+    // The board
+    uint8_t values_[VALUES_COUNT];
+    uint16_t lineMasks_[LINE_COUNT];    // Values used in each unit
+    uint16_t rowMasks_[ROW_COUNT];
+    uint16_t squareMasks_[TINY_COUNT];
+
+    // Stack of the tried positions and of their untried candidates
+    uint8_t positions_[VALUES_COUNT];
+    uint16_t untried_[VALUES_COUNT];
+    int8_t depth_;
+
+    bool valid_;    // Can the current values lead to a solution ?
+
+    boardSolver<GEOMETRY_9> board_;     // Search with obvious values
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_BACKTRACK_ENGINE_h__
+
+// EOF
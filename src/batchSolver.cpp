@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------
+//--
+//--    batchSolver.cpp
+//--
+//--        Implementation of batchSolver object - Solve many boards
+//--        in a single call
+//--
+//----------------------------------------------------------------------
+
+#include "batchSolver.h"
+
+// Construction
+//
+//  @mode : ID of the engine to use (a SEARCH_MODE value)
+//
+batchSolver::batchSolver(uint8_t mode)
+:backtrack_((SEARCH_MODE_DLX == mode || mode >= SEARCH_MODE_COUNT)?
+                (uint8_t)SEARCH_MODE_PROPAGATE:mode){
+    engine_ = ((SEARCH_MODE_DLX == mode)?
+                (solverEngine*)&dlx_:(solverEngine*)&backtrack_);
+    nodes_ = 0;
+}
+
+// solve() : Solve boards
+//
+//  @boards : values of the boards, VALUES_COUNT values per board
+//          (EMPTY_VALUE for empty elements)
+//  @count : # of boards
+//  @solutions : will receive the solution of each board,
+//          VALUES_COUNT values per board (can be @boards).
+//          Boards with no solution are copied unchanged
+//  @status : will receive the status of each board (a BATCH_STATUS
+//          value). Can be NULL
+//
+//  @return : # of boards solved
+//
+uint32_t batchSolver::solve(const uint8_t* boards, uint32_t count,
+                            uint8_t* solutions, uint8_t* status){
+    uint32_t solved(0);
+    uint8_t result, index;
+    nodes_ = 0;
+    for (uint32_t id(0); id < count; id++){
+        if (solutions != boards){
+            memcpy(solutions, boards, VALUES_COUNT);
+        }
+
+        // All the values must be valid
+        result = BATCH_SOLVED;
+        for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+            if (solutions[index] > VALUE_MAX){
+                result = BATCH_INVALID;
+                break;
+            }
+        }
+
+        if (BATCH_SOLVED == result){
+            if (engine_->solve(solutions)){
+                solved++;
+            }
+            else{
+                result = BATCH_NO_SOLUTION;
+            }
+
+            nodes_ += engine_->nodes();
+        }
+
+        if (status){
+            status[id] = result;
+        }
+
+        // Next board
+        boards += VALUES_COUNT;
+        solutions += VALUES_COUNT;
+    }
+
+    return solved;
+}
+
+// grade() : Rate boards
+//
+//  @boards : values of the boards, VALUES_COUNT values per board
+//          (EMPTY_VALUE for empty elements)
+//  @count : # of boards
+//  @ratings : will receive the rating of each board (see
+//          humanSolver::grade())
+//  @hardest : will receive the ID of the most expensive technique
+//          used for each board. Can be NULL
+//
+//  @return : # of boards solved with the techniques
+//
+uint32_t batchSolver::grade(const uint8_t* boards, uint32_t count,
+                            int8_t* ratings, int8_t* hardest){
+    uint32_t solved(0);
+    for (uint32_t id(0); id < count; id++){
+        ratings[id] = human_.grade(boards);
+        if (human_.solved()){
+            solved++;
+        }
+
+        if (hardest){
+            hardest[id] = human_.hardest();
+        }
+
+        boards += VALUES_COUNT;
+    }
+
+    return solved;
+}
+
+// EOF
@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------
+//--
+//--    batchSolver.h
+//--
+//--        Definition of batchSolver object - Solve many boards
+//--        in a single call
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_BATCH_SOLVER_h__
+#define __S_SOLVER_BATCH_SOLVER_h__    1
+
+#include "backtrackEngine.h"
+#include "dlxSolver.h"
+#include "humanSolver.h"
+
+// Status of a board
+//
+enum BATCH_STATUS{
+    BATCH_SOLVED = 0,       // A solution has been found
+    BATCH_NO_SOLUTION = 1,  // The board can't be solved
+    BATCH_INVALID = 2       // A value is out of range
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+//   batchSolver : Solve many boards in a single call
+//
+//      A batchSolver owns its engine : it shares nothing with the other
+//      objects, so many batchSolver objects can be used at the same time.
+//      No UI code is used.
+//
+class batchSolver{
+public:
+
+    // Construction
+    //
+    //  @mode : ID of the engine to use (a SEARCH_MODE value)
+    //
+    batchSolver(uint8_t mode = SOLVER_ENGINE_DEFAULT);
+    batchSolver(const batchSolver&) = delete;
+
+    // Destruction
+    ~batchSolver(){}
+
+    // solve() : Solve boards
+    //
+    //  @boards : values of the boards, VALUES_COUNT values per board
+    //          (EMPTY_VALUE for empty elements)
+    //  @count : # of boards
+    //  @solutions : will receive the solution of each board,
+    //          VALUES_COUNT values per board (can be @boards).
+    //          Boards with no solution are copied unchanged
+    //  @status : will receive the status of each board (a BATCH_STATUS
+    //          value). Can be NULL
+    //
+    //  @return : # of boards solved
+    //
+    uint32_t solve(const uint8_t* boards, uint32_t count,
+                    uint8_t* solutions, uint8_t* status = NULL);
+
+    // grade() : Rate boards
+    //
+    //  @boards : values of the boards, VALUES_COUNT values per board
+    //          (EMPTY_VALUE for empty elements)
+    //  @count : # of boards
+    //  @ratings : will receive the rating of each board (see
+    //          humanSolver::grade())
+    //  @hardest : will receive the ID of the most expensive technique
+    //          used for each board. Can be NULL
+    //
+    //  @return : # of boards solved with the techniques
+    //
+    uint32_t grade(const uint8_t* boards, uint32_t count,
+                    int8_t* ratings, int8_t* hardest = NULL);
+
+    // nodes() : # of values tried during the last call to solve()
+    //
+    //  @return : count of "search nodes"
+    //
+    uint32_t nodes(){
+        return nodes_;
+    }
+
+    // Members
+private:
+    backtrackEngine backtrack_;
+    dlxSolver dlx_;
+    solverEngine* engine_;      // The one that is used
+    humanSolver human_;         // For ratings
+    uint32_t nodes_;
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_BATCH_SOLVER_h__
+
+// EOF
@@ -0,0 +1,150 @@
+//----------------------------------------------------------------------
+//--
+//--    boardGeometry.h
+//--
+//--        Dimensions, types and lookup tables of a board, for any
+//--        size of tinySquare (box)
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_BOARD_GEOMETRY_h__
+#define __S_SOLVER_BOARD_GEOMETRY_h__    1
+
+#include "consts.h"
+#include "element.h"
+
+// Sizes of boxes (in lines or rows)
+//
+#define BOX_SIZE_MIN    2
+#define BOX_SIZE_MAX    5
+
+// Templates can't have a "C" linkage : no extern "C" block here
+
+// __boardMask : Type of the masks of values (one bit per value)
+//
+template<bool WIDE> struct __boardMask{
+    typedef uint16_t type;
+};
+
+template<> struct __boardMask<true>{
+    typedef uint32_t type;
+};
+
+// __boardIndex : Type of the indexes of the positions
+//
+template<bool WIDE> struct __boardIndex{
+    typedef uint8_t type;
+};
+
+template<> struct __boardIndex<true>{
+    typedef uint16_t type;
+};
+
+//   boardGeometry : Dimensions of a board made of @BOX_LINES x @BOX_ROWS
+//                  boxes
+//
+//      A board has as many lines, rows, boxes and values as a box has
+//      positions. Boxes are numbered from left to right, then from top
+//      to bottom, like the positions.
+//      Everything is known at compile time : the types of the masks and
+//      of the indexes are the smallest ones that fit
+//
+template<uint8_t BOX_LINES, uint8_t BOX_ROWS>
+struct boardGeometry{
+    static_assert(BOX_LINES >= BOX_SIZE_MIN && BOX_LINES <= BOX_SIZE_MAX
+                && BOX_ROWS >= BOX_SIZE_MIN && BOX_ROWS <= BOX_SIZE_MAX,
+                "Unsupported size of box");
+
+    static constexpr uint8_t boxLines = BOX_LINES;  // # of lines in a box
+    static constexpr uint8_t boxRows = BOX_ROWS;    // # of rows in a box
+
+    // # of lines, of rows, of boxes and of values
+    static constexpr uint8_t size = BOX_LINES * BOX_ROWS;
+    static constexpr uint16_t positions = size * size;
+
+    // Units : lines, rows and boxes
+    static constexpr uint8_t unitCount = 3 * size;
+    static constexpr uint8_t unitLine = 0;              // First line ID
+    static constexpr uint8_t unitRow = unitLine + size; // First row ID
+    static constexpr uint8_t unitBox = unitRow + size;  // First box ID
+
+    typedef typename __boardMask<(size > 16)>::type MASK;
+    typedef typename __boardIndex<(positions > UINT8_MAX)>::type INDEX;
+
+    static constexpr MASK allValues = (MASK)((1UL << size) - 1);
+
+    // bit() : Bit of a value in a mask
+    //
+    //  @value : value in [VALUE_MIN, size]
+    //
+    //  @return : the bit
+    //
+    static constexpr MASK bit(uint8_t value){
+        return (MASK)((MASK)1 << (value - VALUE_MIN));
+    }
+};
+
+// Boards handled by the engine
+//
+typedef boardGeometry<2, 2> GEOMETRY_4;     // 4 x 4 boards
+typedef boardGeometry<3, 3> GEOMETRY_9;     // The app.'s grids
+typedef boardGeometry<4, 4> GEOMETRY_16;    // 16 x 16 boards
+typedef boardGeometry<5, 5> GEOMETRY_25;    // 25 x 25 boards
+
+static_assert(GEOMETRY_9::size == VALUE_MAX
+            && GEOMETRY_9::positions == (VALUES_COUNT),
+            "Geometry and grid don't match");
+
+// Lookup tables of a board
+//
+template<class GEOMETRY>
+struct BOARD_TABLES{
+    uint8_t line[GEOMETRY::positions];      // Line of each position
+    uint8_t row[GEOMETRY::positions];       // Row of each position
+    uint8_t box[GEOMETRY::positions];       // Box of each position
+
+    // Positions of each unit
+    typename GEOMETRY::INDEX units[GEOMETRY::unitCount][GEOMETRY::size];
+};
+
+// __buildBoardTables() : Fill all the lookup tables of a board
+//
+//  @return : the tables
+//
+template<class GEOMETRY>
+constexpr BOARD_TABLES<GEOMETRY> __buildBoardTables(){
+    BOARD_TABLES<GEOMETRY> tables{};
+    uint8_t counts[GEOMETRY::unitCount]{};
+    uint8_t line(0), row(0), box(0);
+
+    for (uint16_t index(0); index < GEOMETRY::positions; index++){
+        line = index / GEOMETRY::size;
+        row = index % GEOMETRY::size;
+        box = GEOMETRY::boxLines * (line / GEOMETRY::boxLines)
+                + row / GEOMETRY::boxRows;
+
+        tables.line[index] = line;
+        tables.row[index] = row;
+        tables.box[index] = box;
+
+        // Positions are added to their units in index order
+        line += GEOMETRY::unitLine;
+        row += GEOMETRY::unitRow;
+        box += GEOMETRY::unitBox;
+        tables.units[line][counts[line]++] = index;
+        tables.units[row][counts[row]++] = index;
+        tables.units[box][counts[box]++] = index;
+    }
+
+    return tables;
+}
+
+// Tables are generated at compile time
+//
+template<class GEOMETRY>
+constexpr BOARD_TABLES<GEOMETRY> gBoardTables =
+                                    __buildBoardTables<GEOMETRY>();
+
+#endif // __S_SOLVER_BOARD_GEOMETRY_h__
+
+// EOF
@@ -0,0 +1,519 @@
+//----------------------------------------------------------------------
+//--
+//--    boardSolver.cpp
+//--
+//--        Implementation of boardSolver template - Search and creation
+//--        of boards of any geometry
+//--
+//----------------------------------------------------------------------
+
+#include "boardSolver.h"
+
+// Construction
+//
+template<class GEOMETRY>
+boardSolver<GEOMETRY>::boardSolver(){
+    nodes_ = 0;
+    budget_ = NULL;
+    trailSize_ = 0;
+    depth_ = -1;
+    valid_ = false;
+    _clearPending();
+}
+
+// countSolutions() : Count the solutions of a board
+//
+//  @values : values of the board
+//  @limit : max. # of solutions to search for
+//
+//  @return : # of solutions found (at most @limit)
+//
+template<class GEOMETRY>
+uint8_t boardSolver<GEOMETRY>::countSolutions(const uint8_t* values,
+                                                uint8_t limit){
+    uint8_t count(0);
+    start(values);
+    while (count < limit && next()){
+        count++;
+    }
+
+    if (budget_){
+        budget_->solutions = count;
+    }
+
+    return count;
+}
+
+// propagate() : Set the obvious values of a board until none
+//              can be found
+//
+//  @values : values of the board. Will receive the obvious values
+//
+//  @return : # of obvious values set or -1 if the board
+//            can't be solved
+//
+template<class GEOMETRY>
+int16_t boardSolver<GEOMETRY>::propagate(uint8_t* values){
+    nodes_ = 0;
+    trailSize_ = 0;
+    if (!_load(values) || !_propagate()){
+        return -1;
+    }
+
+    memcpy(values, values_, GEOMETRY::positions);
+    return trailSize_;
+}
+
+// create() : Create a new board with a single solution
+//
+//  @values : will receive the values of the board
+//  @clues : min. # of values to keep
+//  @random : random numbers
+//
+//  @return : # of clues or 0 if no complete board was found
+//          within the budget
+//
+template<class GEOMETRY>
+uint16_t boardSolver<GEOMETRY>::create(uint8_t* values, uint16_t clues,
+                                        randomGenerator& random){
+    // step 1 : a complete board
+    //  (some values in the diagonal can't be completed)
+    bool found(false);
+    do{
+        _fillDiagonal(values, random);
+    } while (!(found = solve(values)) && !exhausted());
+
+    if (!found){
+        return 0;
+    }
+
+    // step 2 : positions in a random order
+    uint16_t index, other;
+    for (index = 0; index < GEOMETRY::positions; index++){
+        other = random.below(index + 1);
+        order_[index] = order_[other];
+        order_[other] = index;
+    }
+
+    // step 3 : remove values while the solution is unique
+    uint16_t count(GEOMETRY::positions);
+    uint8_t value;
+    INDEX pos;
+    for (index = 0; index < GEOMETRY::positions && count > clues
+        && !exhausted(); index++){
+        pos = order_[index];
+        value = values[pos];
+        values[pos] = EMPTY_VALUE;
+        if (_hasOtherSolution(values, pos, value)){
+            values[pos] = value;    // Needed
+        }
+        else{
+            count--;
+        }
+    }
+
+    return count;
+}
+
+// start() : Start a search through the solutions of a board
+//
+//  @values : values of the board
+//
+template<class GEOMETRY>
+void boardSolver<GEOMETRY>::start(const uint8_t* values){
+    nodes_ = 0;
+    trailSize_ = 0;
+    depth_ = -1;
+    valid_ = (_load(values) && _propagate());
+}
+
+// next() : Search for the next solution
+//
+//  @solution : table that will receive the values of the solution.
+//          Can be NULL
+//
+//  @return : true if a new solution has been found
+//
+template<class GEOMETRY>
+bool boardSolver<GEOMETRY>::next(uint8_t* solution){
+    INDEX pos;
+    MASK candidates;
+    while (true){
+        if (valid_){
+            if (!_nextPos(pos, candidates)){
+                // No more empty position => a new solution
+                if (solution){
+                    memcpy(solution, values_, GEOMETRY::positions);
+                }
+
+                valid_ = false;     // Next call will search for another
+                return true;
+            }
+
+            if (!candidates){
+                valid_ = false;     // Dead end
+                continue;
+            }
+
+            // A new position in the stack
+            positions_[++depth_] = pos;
+            untried_[depth_] = candidates;
+            marks_[depth_] = trailSize_;
+        }
+        else{
+            // Go back to the last position with candidates left
+            while (depth_ >= 0 && !untried_[depth_]){
+                _undoTrail(marks_[depth_]);
+                _emptyValue(positions_[depth_--]);
+            }
+
+            if (depth_ < 0){
+                return false;   // All candidates have been tried
+            }
+
+            // Remove the values set with the previous try
+            _undoTrail(marks_[depth_]);
+            _emptyValue(positions_[depth_]);
+        }
+
+        // Try the smallest untried candidate
+        candidates = untried_[depth_];
+        untried_[depth_] &= (candidates - 1);
+        _setValue(positions_[depth_], VALUE_MIN + __builtin_ctz(candidates));
+        nodes_++;
+        if (_overBudget()){
+            // Stop here
+            valid_ = false;
+            depth_ = -1;
+            return false;
+        }
+
+        valid_ = _propagate();
+    }
+}
+
+//
+// Internal methods
+//
+
+// _load() : Copy the values of a board and build the masks
+//
+//  All the units are to be searched by the next _propagate()
+//
+//  @values : values of the board
+//
+//  @return : false if a value is used twice in a unit
+//
+template<class GEOMETRY>
+bool boardSolver<GEOMETRY>::_load(const uint8_t* values){
+    memset(masks_, 0, sizeof(masks_));
+    memset(values_, EMPTY_VALUE, sizeof(values_));
+    memset(map_, 0, sizeof(map_));
+    _clearPending();
+
+    bool valid(true);
+    uint16_t index;
+    for (index = 0; index < GEOMETRY::positions; index++){
+        if (EMPTY_VALUE == values[index]){
+            continue;
+        }
+
+        if (values[index] <= GEOMETRY::size
+            && (_candidates(index) & GEOMETRY::bit(values[index]))){
+            values_[index] = values[index];
+            masks_[GEOMETRY::unitLine + gBoardTables<GEOMETRY>.line[index]]
+                |= GEOMETRY::bit(values[index]);
+            masks_[GEOMETRY::unitRow + gBoardTables<GEOMETRY>.row[index]]
+                |= GEOMETRY::bit(values[index]);
+            masks_[GEOMETRY::unitBox + gBoardTables<GEOMETRY>.box[index]]
+                |= GEOMETRY::bit(values[index]);
+        }
+        else{
+            valid = false;  // Already in the line, the row or the box
+        }
+    }
+
+    // Candidates of the empty positions
+    MASK candidates;
+    for (index = 0; index < GEOMETRY::positions; index++){
+        if (EMPTY_VALUE == values_[index]){
+            if (!(candidates = map_[index] = _candidates(index))){
+                conflict_ = true;
+            }
+            else if (!(candidates & (candidates - 1))){
+                singles_[singleCount_++] = index;
+            }
+        }
+    }
+
+    for (uint8_t unit(0); unit < GEOMETRY::unitCount; unit++){
+        _touch(unit);
+    }
+
+    return valid;
+}
+
+// _setValue() : Put a value at an empty position
+//
+//  @index : index of the position
+//  @value : value
+//
+template<class GEOMETRY>
+void boardSolver<GEOMETRY>::_setValue(INDEX index, uint8_t value){
+    MASK bit(GEOMETRY::bit(value)), candidates;
+    uint8_t units[3], unit, id, others[3];
+    INDEX peer;
+
+    values_[index] = value;
+    map_[index] = 0;
+    _units(index, units);
+    for (unit = 0; unit < 3; unit++){
+        masks_[units[unit]] |= bit;
+        _touch(units[unit]);
+    }
+
+    // Remove the value from the candidates of the peers
+    for (unit = 0; unit < 3; unit++){
+        for (id = 0; id < GEOMETRY::size; id++){
+            peer = gBoardTables<GEOMETRY>.units[units[unit]][id];
+            if (!(map_[peer] & bit)){
+                continue;   // Not a candidate (or position not empty)
+            }
+
+            candidates = (map_[peer] &= ~bit);
+            if (!candidates){
+                conflict_ = true;
+            }
+            else if (!(candidates & (candidates - 1))){
+                singles_[singleCount_++] = peer;
+            }
+
+            _units(peer, others);
+            _touch(others[0]);
+            _touch(others[1]);
+            _touch(others[2]);
+        }
+    }
+}
+
+// _emptyValue() : Empty a position
+//
+//  @index : index of the position
+//
+template<class GEOMETRY>
+void boardSolver<GEOMETRY>::_emptyValue(INDEX index){
+    MASK bit(GEOMETRY::bit(values_[index]));
+    uint8_t units[3], unit, id;
+    INDEX peer;
+
+    values_[index] = EMPTY_VALUE;
+    _units(index, units);
+    for (unit = 0; unit < 3; unit++){
+        masks_[units[unit]] &= ~bit;
+    }
+
+    // Only the value can be a candidate again
+    map_[index] = _candidates(index);
+    for (unit = 0; unit < 3; unit++){
+        for (id = 0; id < GEOMETRY::size; id++){
+            peer = gBoardTables<GEOMETRY>.units[units[unit]][id];
+            if (EMPTY_VALUE == values_[peer] && !(map_[peer] & bit)){
+                map_[peer] = _candidates(peer);
+            }
+        }
+    }
+}
+
+// _clearPending() : Forget the queued positions and units
+//
+template<class GEOMETRY>
+void boardSolver<GEOMETRY>::_clearPending(){
+    singleCount_ = 0;
+    unitCount_ = 0;
+    memset(touched_, 0, sizeof(touched_));
+    conflict_ = false;
+}
+
+// _nextPos() : Find the empty position with the fewest candidates
+//
+//  Positions with a single candidate have all been set by
+//  _propagate() : a position with 2 candidates can't be "beaten"
+//
+//  @pos : will receive the index of the found position
+//  @candidates : will receive the candidates of @pos
+//
+//  @return : false if there is no more empty position
+//
+template<class GEOMETRY>
+bool boardSolver<GEOMETRY>::_nextPos(INDEX& pos, MASK& candidates){
+    uint8_t count, minCount(GEOMETRY::size + 1);
+    for (uint16_t index(0); index < GEOMETRY::positions; index++){
+        if (EMPTY_VALUE == values_[index]
+            && (count = __builtin_popcount(map_[index])) < minCount){
+            pos = index;
+            candidates = map_[index];
+            minCount = count;
+
+            if (count <= 2){
+                // Can't find a "better" position
+                return true;
+            }
+        }
+    }
+
+    return (minCount <= GEOMETRY::size);
+}
+
+// _searchUnit() : Set the values with a single position in a unit
+//
+//  @unit : ID of the unit
+//
+//  @return : false if the board can't be solved
+//
+template<class GEOMETRY>
+bool boardSolver<GEOMETRY>::_searchUnit(uint8_t unit){
+    uint8_t id;
+    INDEX index;
+    MASK candidates, once(0), twice(0);
+
+    // Values that are candidates at least once and twice in the unit
+    for (id = 0; id < GEOMETRY::size; id++){
+        candidates = map_[gBoardTables<GEOMETRY>.units[unit][id]];
+        twice |= (once & candidates);
+        once |= candidates;
+    }
+
+    if ((GEOMETRY::allValues & ~masks_[unit]) & ~once){
+        return false;   // A missing value can't be put in the unit
+    }
+
+    if ((once &= ~twice)){
+        for (id = 0; id < GEOMETRY::size; id++){
+            index = gBoardTables<GEOMETRY>.units[unit][id];
+            if ((candidates = (map_[index] & once))){
+                if (candidates & (candidates - 1)){
+                    return false;   // 2 values for a single position
+                }
+
+                _setValue(index, VALUE_MIN + __builtin_ctz(candidates));
+                trail_[trailSize_++] = index;
+            }
+        }
+    }
+
+    return true;
+}
+
+// _propagate() : Set obvious values until none can be found
+//
+//  Indexes of the positions set are added to the trail
+//
+//  @return : false if the board can't be solved
+//
+template<class GEOMETRY>
+bool boardSolver<GEOMETRY>::_propagate(){
+    INDEX index;
+    MASK candidates;
+    uint8_t unit;
+    while (!conflict_ && (singleCount_ || unitCount_)){
+        if (singleCount_){
+            // A position with a single candidate
+            index = singles_[--singleCount_];
+            if ((candidates = map_[index])){
+                _setValue(index, VALUE_MIN + __builtin_ctz(candidates));
+                trail_[trailSize_++] = index;
+            }
+        }
+        else{
+            touched_[unit = units_[--unitCount_]] = false;
+            if (!_searchUnit(unit)){
+                conflict_ = true;
+            }
+        }
+    }
+
+    bool valid(!conflict_);
+    _clearPending();
+    return valid;
+}
+
+// _fillDiagonal() : Put random values in the boxes of the diagonal
+//
+//  @values : values of the board
+//  @random : random numbers
+//
+template<class GEOMETRY>
+void boardSolver<GEOMETRY>::_fillDiagonal(uint8_t* values,
+                                            randomGenerator& random){
+    memset(values, EMPTY_VALUE, GEOMETRY::positions);
+
+    uint8_t order[GEOMETRY::size], id;
+    uint8_t box, boxCount(GEOMETRY::boxLines < GEOMETRY::boxRows?
+                            GEOMETRY::boxLines:GEOMETRY::boxRows);
+    for (box = 0; box < boxCount; box++){
+        // (box, box) is the box of the band #box and of the stack #box
+        random.order(order, GEOMETRY::size);
+        for (id = 0; id < GEOMETRY::size; id++){
+            values[gBoardTables<GEOMETRY>.units[GEOMETRY::unitBox
+                    + box * (GEOMETRY::boxLines + 1)][id]] = VALUE_MIN + order[id];
+        }
+    }
+}
+
+// _hasOtherSolution() : Does a board with a single solution get
+//              another one once a value has been removed ?
+//
+//  A new solution can only have another value at the emptied
+//  position : each other candidate is tried with a search for a
+//  single solution
+//
+//  @values : values of the board, @index already emptied
+//  @index : index of the emptied position
+//  @value : value removed
+//
+//  @return : true if another solution exists (or if the budget
+//          is exhausted)
+//
+template<class GEOMETRY>
+bool boardSolver<GEOMETRY>::_hasOtherSolution(const uint8_t* values,
+                                            INDEX index, uint8_t value){
+    // Values used by the peers of the position
+    MASK used(GEOMETRY::bit(value));
+    uint8_t units[3] = {
+        (uint8_t)(GEOMETRY::unitLine + gBoardTables<GEOMETRY>.line[index]),
+        (uint8_t)(GEOMETRY::unitRow + gBoardTables<GEOMETRY>.row[index]),
+        (uint8_t)(GEOMETRY::unitBox + gBoardTables<GEOMETRY>.box[index])};
+    uint8_t unit, id, other;
+    for (unit = 0; unit < 3; unit++){
+        for (id = 0; id < GEOMETRY::size; id++){
+            if (EMPTY_VALUE !=
+                (other = values[gBoardTables<GEOMETRY>.units[units[unit]][id]])){
+                used |= GEOMETRY::bit(other);
+            }
+        }
+    }
+
+    // Try each other candidate
+    MASK others(GEOMETRY::allValues & ~used);
+    while (others){
+        memcpy(work_, values, GEOMETRY::positions);
+        work_[index] = VALUE_MIN + __builtin_ctz(others);
+        others &= (others - 1);
+        if (solve(work_) || exhausted()){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Instantiations
+//
+template class boardSolver<GEOMETRY_9>;
+#ifndef DEST_CASIO_CALC
+template class boardSolver<GEOMETRY_4>;
+template class boardSolver<GEOMETRY_16>;
+template class boardSolver<GEOMETRY_25>;
+#endif // #ifndef DEST_CASIO_CALC
+
+// EOF
@@ -0,0 +1,331 @@
+//----------------------------------------------------------------------
+//--
+//--    boardSolver.h
+//--
+//--        Definition of boardSolver template - Search and creation
+//--        of boards of any geometry
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_BOARD_SOLVER_h__
+#define __S_SOLVER_BOARD_SOLVER_h__    1
+
+#include "boardGeometry.h"
+#include "solverEngine.h"
+#include "randomGenerator.h"
+
+//   boardSolver : Search for the solutions of a board of any geometry
+//                 and creation of new boards
+//
+//      The empty position with the fewest candidates is filled first
+//      and, after each value tried, all the obvious values are set.
+//      This is the search of backtrackEngine in SEARCH_MODE_PROPAGATE
+//      mode, which uses boardSolver<GEOMETRY_9>.
+//      Masks, indexes and tables are chosen by the @GEOMETRY at compile
+//      time : a mask is a single word, even for 25 values.
+//
+//      The candidates of each position are kept up to date when a value
+//      is set or removed : only the peers of the position change. Only
+//      the units where a candidate has been removed are searched for
+//      obvious values.
+//
+//      A board is a table of GEOMETRY::positions values, EMPTY_VALUE for
+//      empty positions. No memory is allocated.
+//
+//      The template is instantiated in boardSolver.cpp for the
+//      geometries of boardGeometry.h (only GEOMETRY_9 on the calculator)
+//
+template<class GEOMETRY>
+class boardSolver{
+public:
+    typedef typename GEOMETRY::MASK MASK;
+    typedef typename GEOMETRY::INDEX INDEX;
+
+    // Construction
+    boardSolver();
+    boardSolver(const boardSolver&) = delete;
+
+    // Destruction
+    ~boardSolver(){}
+
+    // solve() : Find a solution for a board
+    //
+    //  @values : values of the board. Will receive the values
+    //          of the solution if one is found
+    //
+    //  @return : true if a solution was found
+    //
+    bool solve(uint8_t* values){
+        start(values);
+        return next(values);
+    }
+
+    // countSolutions() : Count the solutions of a board
+    //
+    //  @values : values of the board
+    //  @limit : max. # of solutions to search for
+    //
+    //  @return : # of solutions found (at most @limit)
+    //
+    uint8_t countSolutions(const uint8_t* values, uint8_t limit);
+
+    // propagate() : Set the obvious values of a board until none
+    //              can be found
+    //
+    //  An obvious value is either the only candidate of a position or
+    //  a value that can only be put at one position of a unit
+    //
+    //  @values : values of the board. Will receive the obvious values
+    //
+    //  @return : # of obvious values set or -1 if the board
+    //            can't be solved
+    //
+    int16_t propagate(uint8_t* values);
+
+    // create() : Create a new board with a single solution
+    //
+    //  A complete board is found from random values in the boxes of
+    //  the diagonal. Then values are removed, in a random order, while
+    //  the solution stays unique
+    //
+    //  @values : will receive the values of the board
+    //  @clues : min. # of values to keep
+    //  @random : random numbers
+    //
+    //  @return : # of clues or 0 if no complete board was found
+    //          within the budget
+    //
+    uint16_t create(uint8_t* values, uint16_t clues, randomGenerator& random);
+
+    //
+    // Resumable search
+    //
+
+    // start() : Start a search through the solutions of a board
+    //
+    //  @values : values of the board
+    //
+    void start(const uint8_t* values);
+
+    // next() : Search for the next solution
+    //
+    //  @solution : table that will receive the values of the solution.
+    //          Can be NULL
+    //
+    //  @return : true if a new solution has been found
+    //
+    bool next(uint8_t* solution = NULL);
+
+    //
+    // Limits
+    //
+
+    // nodes() : # of values tried during the last search
+    //
+    //  @return : count of "search nodes"
+    //
+    uint32_t nodes(){
+        return nodes_;
+    }
+
+    // setBudget() : Set the limits of the next searches
+    //
+    //  @budget : limits and statistics of the searches.
+    //          NULL for unlimited searches
+    //
+    void setBudget(SEARCH_BUDGET* budget){
+        budget_ = budget;
+    }
+
+    // exhausted() : Has the last search been stopped before its end ?
+    //
+    //  @return : true if the budget is exhausted
+    //
+    bool exhausted(){
+        return (budget_ && budget_->exhausted);
+    }
+
+private:
+
+    // _load() : Copy the values of a board and build the masks
+    //
+    //  @values : values of the board
+    //
+    //  @return : false if a value is used twice in a unit
+    //
+    bool _load(const uint8_t* values);
+
+    // _setValue() : Put a value at an empty position
+    //
+    //  The value is removed from the candidates of the peers. Peers
+    //  left with a single candidate are queued and the units of the
+    //  peers are to be searched by _propagate()
+    //
+    //  @index : index of the position
+    //  @value : value
+    //
+    void _setValue(INDEX index, uint8_t value);
+
+    // _emptyValue() : Empty a position
+    //
+    //  The candidates of the position and of its peers are computed
+    //  again
+    //
+    //  @index : index of the position
+    //
+    void _emptyValue(INDEX index);
+
+    // _candidates() : Values that can be put at a position
+    //
+    //  @index : index of the position
+    //
+    //  @return : mask of allowed values
+    //
+    MASK _candidates(INDEX index){
+        return (GEOMETRY::allValues
+            & ~(masks_[GEOMETRY::unitLine + gBoardTables<GEOMETRY>.line[index]]
+            | masks_[GEOMETRY::unitRow + gBoardTables<GEOMETRY>.row[index]]
+            | masks_[GEOMETRY::unitBox + gBoardTables<GEOMETRY>.box[index]]));
+    }
+
+    // _units() : Units of a position
+    //
+    //  @index : index of the position
+    //  @units : will receive the IDs of the line, the row and the box
+    //
+    void _units(INDEX index, uint8_t* units){
+        units[0] = GEOMETRY::unitLine + gBoardTables<GEOMETRY>.line[index];
+        units[1] = GEOMETRY::unitRow + gBoardTables<GEOMETRY>.row[index];
+        units[2] = GEOMETRY::unitBox + gBoardTables<GEOMETRY>.box[index];
+    }
+
+    // _touch() : A unit is to be searched for obvious values
+    //
+    //  @unit : ID of the unit
+    //
+    void _touch(uint8_t unit){
+        if (!touched_[unit]){
+            touched_[unit] = true;
+            units_[unitCount_++] = unit;
+        }
+    }
+
+    // _clearPending() : Forget the queued positions and units
+    //
+    void _clearPending();
+
+    // _nextPos() : Find the empty position with the fewest candidates
+    //
+    //  @pos : will receive the index of the found position
+    //  @candidates : will receive the candidates of @pos
+    //
+    //  @return : false if there is no more empty position
+    //
+    bool _nextPos(INDEX& pos, MASK& candidates);
+
+    // _searchUnit() : Set the values with a single position in a unit
+    //
+    //  @unit : ID of the unit
+    //
+    //  @return : false if the board can't be solved
+    //
+    bool _searchUnit(uint8_t unit);
+
+    // _propagate() : Set obvious values until none can be found
+    //
+    //  Positions with a single candidate and values with a single
+    //  position in the touched units are set. Indexes of the
+    //  positions set are added to the trail
+    //
+    //  @return : false if the board can't be solved
+    //
+    bool _propagate();
+
+    // _undoTrail() : Empty the positions set after a mark in the trail
+    //
+    //  @mark : new size of the trail
+    //
+    void _undoTrail(INDEX mark){
+        while (trailSize_ > mark){
+            _emptyValue(trail_[--trailSize_]);
+        }
+    }
+
+    // _overBudget() : Count a new node and check the limits
+    //
+    //  @return : true if the search must stop
+    //
+    bool _overBudget(){
+        return (budget_ && solverEngine::checkBudget(*budget_));
+    }
+
+    // _fillDiagonal() : Put random values in the boxes of the diagonal
+    //
+    //  These boxes share no unit : any values can be put in them
+    //
+    //  @values : values of the board
+    //  @random : random numbers
+    //
+    void _fillDiagonal(uint8_t* values, randomGenerator& random);
+
+    // _hasOtherSolution() : Does a board with a single solution get
+    //              another one once a value has been removed ?
+    //
+    //  @values : values of the board, @index already emptied
+    //  @index : index of the emptied position
+    //  @value : value removed
+    //
+    //  @return : true if another solution exists (or if the budget
+    //          is exhausted)
+    //
+    bool _hasOtherSolution(const uint8_t* values, INDEX index,
+                            uint8_t value);
+
+    // Members
+private:
+    uint32_t nodes_;
+    SEARCH_BUDGET* budget_;     // Limits of the search
+
+    // The board
+    uint8_t values_[GEOMETRY::positions];
+    MASK masks_[GEOMETRY::unitCount];   // Values used in each unit
+    MASK map_[GEOMETRY::positions];     // Candidates of each position
+
+    // Pending work of _propagate()
+    INDEX singles_[GEOMETRY::positions];    // Positions with 1 candidate
+    INDEX singleCount_;
+    uint8_t units_[GEOMETRY::unitCount];    // Touched units
+    uint8_t unitCount_;
+    bool touched_[GEOMETRY::unitCount];
+    bool conflict_;     // A position has no candidate left
+
+    // Search state
+    INDEX trail_[GEOMETRY::positions];  // Positions set by propagation
+    INDEX trailSize_;
+
+    // Stack of the tried positions, of their untried candidates
+    // and of the trail's size before each try
+    INDEX positions_[GEOMETRY::positions];
+    MASK untried_[GEOMETRY::positions];
+    INDEX marks_[GEOMETRY::positions];
+    int16_t depth_;
+
+    bool valid_;    // Can the current values lead to a solution ?
+
+    // Boards used by create()
+    uint8_t work_[GEOMETRY::positions];
+    INDEX order_[GEOMETRY::positions];
+};
+
+// Instantiated in boardSolver.cpp
+//
+extern template class boardSolver<GEOMETRY_9>;
+#ifndef DEST_CASIO_CALC
+extern template class boardSolver<GEOMETRY_4>;
+extern template class boardSolver<GEOMETRY_16>;
+extern template class boardSolver<GEOMETRY_25>;
+#endif // #ifndef DEST_CASIO_CALC
+
+#endif // __S_SOLVER_BOARD_SOLVER_h__
+
+// EOF
@@ -56,6 +56,11 @@ extern "C" {
 #define VALUE_MIN   1
 #define VALUE_MAX   ROW_COUNT
 
+// Values as bits in a mask
+//  bit (value - 1) is set when value is "used"
+#define VALUE_BIT(value)    ((uint16_t)(1 << ((value) - VALUE_MIN)))
+#define ALL_VALUES_MASK     ((uint16_t)((1 << VALUE_MAX) - 1))
+
 // Blinking
 //
 #define BLINK_TICK_DURATION     100 //  in ms
@@ -124,6 +129,8 @@ extern "C" {
 #define FILE_TEXT               "File : %s"
 #define FILE_ERROR_SAVE_TEXT    "Error saving : %d"
 #define FILE_ERROR_LOAD_TEXT    "Error loading : %d"
+#define FILE_DUPLICATE_TEXT     "Same grid as %d"
+#define FILE_DUPLICATES_TEXT    "%d duplicated grid(s)"
 #define FILE_TEXT_X             TEXT_BASE_X
 #define FILE_TEXT_Y             TEXT_BASE_Y
 #define FILE_TEXT_ERROR_Y       TEXT_V_BASE
@@ -140,6 +147,11 @@ extern "C" {
 #define SOL_X                   TEXT_BASE_X
 #define SOL_Y                   (TEXT_BASE_Y + 2 * TEXT_V_OFFSET)
 
+// Search nodes
+#define NODES_TEXT              "%d nodes"
+#define NODES_X                 TEXT_BASE_X
+#define NODES_Y                 (TEXT_BASE_Y + 3 * TEXT_V_OFFSET)
+
 // # values
 #define VALUES_TEXT             "Val. %d / %d    "
 #define VALUES_X                TEXT_BASE_X
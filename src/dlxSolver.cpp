@@ -0,0 +1,399 @@
+//----------------------------------------------------------------------
+//--
+//--    dlxSolver.cpp
+//--
+//--        Implementation of dlxSolver object - Exact cover search
+//--        (Algorithm X with "dancing links")
+//--
+//----------------------------------------------------------------------
+
+#include "dlxSolver.h"
+#include "element.h"
+#include "tinySquare.h"
+
+// First column of each constraint type
+#define DLX_COL_ELEMENT     0
+#define DLX_COL_LINE        (DLX_COL_ELEMENT + VALUES_COUNT)
+#define DLX_COL_ROW         (DLX_COL_LINE + VALUES_COUNT)
+#define DLX_COL_SQUARE      (DLX_COL_ROW + VALUES_COUNT)
+
+// Construction
+//
+dlxSolver::dlxSolver(){
+    links_ = NULL;  // Allocated when needed
+    left_ = right_ = up_ = down_ = col_ = size_ = NULL;
+}
+
+// Destruction
+//
+dlxSolver::~dlxSolver(){
+    if (links_){
+        free(links_);
+    }
+}
+
+// propagate() : Set the obvious values of a board until none
+//              can be found
+//
+//  Obvious values are the rows of the columns with a single row
+//
+//  @values : values of the board. Will receive the obvious values
+//
+//  @return : # of obvious values set or -1 if the board
+//            can't be solved
+//
+int8_t dlxSolver::propagate(uint8_t* values){
+    nodes_ = 0;
+    if (!values || !_init()){
+        return -1;
+    }
+
+    uint16_t givens[VALUES_COUNT];
+    uint8_t givenCount;
+    bool valid(_selectGivens(values, givens, givenCount));
+
+    // Select the rows of the columns with a single row
+    int8_t depth(0);
+    uint16_t col, node;
+    while (valid && right_[DLX_ROOT] != DLX_ROOT){
+        if (!size_[col = _chooseColumn()]){
+            valid = false;  // A constraint can't be satisfied
+        }
+        else{
+            if (size_[col] > 1){
+                break;      // No more obvious value
+            }
+
+            _cover(col);
+            stack_[depth++] = node = down_[col];
+            _coverOthers(node);
+        }
+    }
+
+    int8_t count(valid?depth:-1);
+    while (depth){
+        node = stack_[--depth];
+        if (valid){
+            col = _rowCandidate(node);
+            values[col / VALUE_MAX] = VALUE_MIN + col % VALUE_MAX;
+        }
+
+        _uncoverOthers(node);
+        _uncover(col_[node]);
+    }
+
+    _unselectGivens(givens, givenCount);
+    return count;
+}
+
+//
+// Internal methods
+//
+
+// _search() : Search for the solutions of a grid
+//
+//  @values : values of the grid (EMPTY_VALUE for empty elements)
+//  @limit : max. # of solutions to search for
+//  @solution : table that will receive the first solution found.
+//              Can be NULL or @values
+//
+//  @return : # of solutions found (at most @limit)
+//
+uint8_t dlxSolver::_search(const uint8_t* values, uint8_t limit,
+                        uint8_t* solution){
+    nodes_ = 0;
+    if (!values || !limit || !_init()){
+        return 0;
+    }
+
+    // Original values are selected rows
+    uint16_t givens[VALUES_COUNT];
+    uint8_t givenCount, index;
+    bool valid(_selectGivens(values, givens, givenCount));
+
+    uint8_t found(0);
+    int8_t depth(0);
+    uint16_t node, col;
+    bool forward(true);
+    while (valid){
+        if (forward){
+            if (right_[DLX_ROOT] == DLX_ROOT){
+                // All the constraints are satisfied => a new solution
+                if (!(found++) && solution){
+                    if (solution != values){
+                        memcpy(solution, values, VALUES_COUNT);
+                    }
+
+                    for (index = 0; index < depth; index++){
+                        node = _rowCandidate(stack_[index]);
+                        solution[node / VALUE_MAX] =
+                                        VALUE_MIN + node % VALUE_MAX;
+                    }
+                }
+
+                if (found >= limit){
+                    break;
+                }
+
+                forward = false;    // Search for another one
+                continue;
+            }
+
+            // Try the rows of the most constrained column
+            if (!size_[col = _chooseColumn()]){
+                forward = false;    // Dead end
+                continue;
+            }
+
+            _cover(col);
+            node = down_[col];
+        }
+        else{
+            if (!depth){
+                break;  // All the rows have been tried
+            }
+
+            // Next row in the column
+            node = stack_[--depth];
+            _uncoverOthers(node);
+            node = down_[node];
+            if (node == (col = col_[node])){
+                // No more row
+                _uncover(col);
+                continue;
+            }
+        }
+
+        // Select the row
+        stack_[depth++] = node;
+        _coverOthers(node);
+        nodes_++;
+        if (_overBudget()){
+            break;  // Stop here
+        }
+
+        forward = true;
+    }
+
+    // Restore the matrix
+    while (depth){
+        node = stack_[--depth];
+        _uncoverOthers(node);
+        _uncover(col_[node]);
+    }
+
+    _unselectGivens(givens, givenCount);
+    if (budget_){
+        budget_->solutions = found;
+    }
+
+    return found;
+}
+
+// _selectGivens() : Select the rows of the values of a grid
+//
+//  @values : values of the grid (EMPTY_VALUE for empty elements)
+//  @givens : will receive the first node of each selected row
+//  @count : will receive the # of selected rows
+//
+//  @return : false if a value can't be put in the grid
+//
+bool dlxSolver::_selectGivens(const uint8_t* values, uint16_t* givens,
+                                uint8_t& count){
+    count = 0;
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        if (values[index] != EMPTY_VALUE){
+            givens[count] = DLX_FIRST_NODE + DLX_CONSTRAINTS *
+                            (index * VALUE_MAX + values[index] - VALUE_MIN);
+            if (!_selectRow(givens[count])){
+                return false;
+            }
+
+            count++;
+        }
+    }
+
+    return true;
+}
+
+// _unselectGivens() : Put back the rows selected by _selectGivens()
+//
+//  @givens : first node of each selected row
+//  @count : # of selected rows
+//
+void dlxSolver::_unselectGivens(uint16_t* givens, uint8_t count){
+    uint16_t node;
+    while (count){
+        node = givens[--count];
+        do{
+            node = left_[node];
+            _uncover(col_[node]);
+        } while (node != givens[count]);
+    }
+}
+
+// _init() : Allocate and link all the nodes of the matrix
+//
+//  @return : true if the matrix is ready
+//
+bool dlxSolver::_init(){
+    if (links_){
+        return true;    // Already done
+    }
+
+    if (NULL == (links_ = (uint16_t*)malloc(sizeof(uint16_t) *
+                            (5 * DLX_NODE_COUNT + DLX_COL_COUNT)))){
+        return false;
+    }
+
+    left_ = links_;
+    right_ = left_ + DLX_NODE_COUNT;
+    up_ = right_ + DLX_NODE_COUNT;
+    down_ = up_ + DLX_NODE_COUNT;
+    col_ = down_ + DLX_NODE_COUNT;
+    size_ = col_ + DLX_NODE_COUNT;
+
+    // Columns' headers
+    uint16_t col;
+    for (col = 0; col < DLX_COL_COUNT; col++){
+        left_[col] = (col?(col - 1):DLX_ROOT);
+        right_[col] = col + 1;  // last one points to root
+        up_[col] = down_[col] = col_[col] = col;
+        size_[col] = 0;
+    }
+
+    left_[DLX_ROOT] = DLX_COL_COUNT - 1;
+    right_[DLX_ROOT] = 0;
+
+    // One row per candidate
+    uint16_t node(DLX_FIRST_NODE), cols[DLX_CONSTRAINTS];
+    uint8_t index, line, row, value, id;
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        line = index / ROW_COUNT;
+        row = index % ROW_COUNT;
+        for (value = 0; value < VALUE_MAX; value++){
+            cols[0] = DLX_COL_ELEMENT + index;
+            cols[1] = DLX_COL_LINE + line * VALUE_MAX + value;
+            cols[2] = DLX_COL_ROW + row * VALUE_MAX + value;
+            cols[3] = DLX_COL_SQUARE + value + VALUE_MAX *
+                        (TINY_ROW_COUNT * (line / TINY_LINE_COUNT)
+                        + row / TINY_ROW_COUNT);
+
+            for (id = 0; id < DLX_CONSTRAINTS; id++){
+                // Add at the bottom of the column
+                col = cols[id];
+                col_[node] = col;
+                up_[node] = up_[col];
+                down_[node] = col;
+                down_[up_[col]] = node;
+                up_[col] = node;
+                size_[col]++;
+
+                // Circular list of the row
+                left_[node] = (id?(node - 1):(node + DLX_CONSTRAINTS - 1));
+                right_[node] = ((id < (DLX_CONSTRAINTS - 1))?
+                                    (node + 1):(node + 1 - DLX_CONSTRAINTS));
+                node++;
+            }
+        }
+    }
+
+    return true;
+}
+
+// _cover() : Remove a column and all the rows it contains
+//
+//  @col : column to cover
+//
+void dlxSolver::_cover(uint16_t col){
+    left_[right_[col]] = left_[col];
+    right_[left_[col]] = right_[col];
+
+    for (uint16_t row = down_[col]; row != col; row = down_[row]){
+        for (uint16_t node = right_[row]; node != row; node = right_[node]){
+            up_[down_[node]] = up_[node];
+            down_[up_[node]] = down_[node];
+            size_[col_[node]]--;
+        }
+    }
+}
+
+// _uncover() : Put back a previously covered column
+//
+//  @col : column to uncover
+//
+void dlxSolver::_uncover(uint16_t col){
+    for (uint16_t row = up_[col]; row != col; row = up_[row]){
+        for (uint16_t node = left_[row]; node != row; node = left_[node]){
+            size_[col_[node]]++;
+            up_[down_[node]] = node;
+            down_[up_[node]] = node;
+        }
+    }
+
+    left_[right_[col]] = col;
+    right_[left_[col]] = col;
+}
+
+// _selectRow() : Put the candidate of a row in the solution
+//
+//  The row is selected only if its columns are all still present
+//
+//  @first : first node of the row
+//
+//  @return : true if selected
+//
+bool dlxSolver::_selectRow(uint16_t first){
+    uint16_t node(first);
+    do{
+        if (right_[left_[col_[node]]] != col_[node]){
+            return false;   // Column is already covered
+        }
+        node = right_[node];
+    } while (node != first);
+
+    do{
+        _cover(col_[node]);
+        node = right_[node];
+    } while (node != first);
+
+    return true;
+}
+
+// _coverOthers() : Cover the other columns of a row
+//
+//  @node : a node of the row whose column is already covered
+//
+void dlxSolver::_coverOthers(uint16_t node){
+    for (uint16_t other = right_[node]; other != node; other = right_[other]){
+        _cover(col_[other]);
+    }
+}
+
+// _uncoverOthers() : Uncover the other columns of a row
+//
+//  @node : a node of the row
+//
+void dlxSolver::_uncoverOthers(uint16_t node){
+    for (uint16_t other = left_[node]; other != node; other = left_[other]){
+        _uncover(col_[other]);
+    }
+}
+
+// _chooseColumn() : Column with the fewest rows
+//
+//  @return : column index
+//
+uint16_t dlxSolver::_chooseColumn(){
+    uint16_t best(right_[DLX_ROOT]);
+    for (uint16_t col = right_[best]; col != DLX_ROOT && size_[best] > 1;
+        col = right_[col]){
+        if (size_[col] < size_[best]){
+            best = col;
+        }
+    }
+
+    return best;
+}
+
+// EOF
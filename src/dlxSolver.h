@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------
+//--
+//--    dlxSolver.h
+//--
+//--        Definition of dlxSolver object - Exact cover search
+//--        (Algorithm X with "dancing links")
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_DLX_SOLVER_h__
+#define __S_SOLVER_DLX_SOLVER_h__    1
+
+#include "solverEngine.h"
+
+// Dimensions of the exact cover matrix
+//
+//  4 constraints types : one value per element, per line, per row
+//  and per tinySquare
+#define DLX_CONSTRAINTS     4
+#define DLX_COL_COUNT       (DLX_CONSTRAINTS * VALUES_COUNT)    // 324
+#define DLX_ROW_COUNT       (VALUE_MAX * VALUES_COUNT)          // 729
+
+// Nodes
+#define DLX_ROOT            DLX_COL_COUNT   // after columns' headers
+#define DLX_FIRST_NODE      (DLX_ROOT + 1)
+#define DLX_NODE_COUNT      (DLX_FIRST_NODE + DLX_CONSTRAINTS * DLX_ROW_COUNT)
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+//   dlxSolver : Search for the solutions of a grid as an exact cover problem
+//
+//      Each row of the matrix is a candidate (a value at a position)
+//      and each column a constraint.
+//      All the nodes are allocated once, the first time a grid is solved.
+//
+class dlxSolver : public solverEngine{
+public:
+
+    // Construction
+    dlxSolver();
+    dlxSolver(const dlxSolver&) = delete;
+
+    // Destruction
+    ~dlxSolver();
+
+    // name() : Name of the engine
+    //
+    //  @return : the name
+    //
+    const char* name(){
+        return "dlx";
+    }
+
+    // solve() : Find a solution for a board
+    //
+    //  @values : values of the board. Will receive the values
+    //          of the solution if one is found
+    //
+    //  @return : true if a solution was found
+    //
+    bool solve(uint8_t* values){
+        return (1 == _search(values, 1, values));
+    }
+
+    // countSolutions() : Count the solutions of a board
+    //
+    //  @values : values of the board
+    //  @limit : max. # of solutions to search for
+    //
+    //  @return : # of solutions found (at most @limit)
+    //
+    uint8_t countSolutions(const uint8_t* values, uint8_t limit){
+        return _search(values, limit);
+    }
+
+    // propagate() : Set the obvious values of a board until none
+    //              can be found
+    //
+    //  Obvious values are the rows of the columns with a single row
+    //
+    //  @values : values of the board. Will receive the obvious values
+    //
+    //  @return : # of obvious values set or -1 if the board
+    //            can't be solved
+    //
+    int8_t propagate(uint8_t* values);
+
+private:
+
+    // _search() : Search for the solutions of a grid
+    //
+    //  @values : values of the grid (EMPTY_VALUE for empty elements)
+    //  @limit : max. # of solutions to search for
+    //  @solution : table that will receive the first solution found.
+    //              Can be NULL or @values
+    //
+    //  @return : # of solutions found (at most @limit)
+    //
+    uint8_t _search(const uint8_t* values, uint8_t limit,
+                    uint8_t* solution = NULL);
+
+    // _selectGivens() : Select the rows of the values of a grid
+    //
+    //  @values : values of the grid (EMPTY_VALUE for empty elements)
+    //  @givens : will receive the first node of each selected row
+    //  @count : will receive the # of selected rows
+    //
+    //  @return : false if a value can't be put in the grid
+    //
+    bool _selectGivens(const uint8_t* values, uint16_t* givens,
+                        uint8_t& count);
+
+    // _unselectGivens() : Put back the rows selected by _selectGivens()
+    //
+    //  @givens : first node of each selected row
+    //  @count : # of selected rows
+    //
+    void _unselectGivens(uint16_t* givens, uint8_t count);
+
+    // _init() : Allocate and link all the nodes of the matrix
+    //
+    //  @return : true if the matrix is ready
+    //
+    bool _init();
+
+    // _cover() : Remove a column and all the rows it contains
+    //
+    //  @col : column to cover
+    //
+    void _cover(uint16_t col);
+
+    // _uncover() : Put back a previously covered column
+    //
+    //  @col : column to uncover
+    //
+    void _uncover(uint16_t col);
+
+    // _selectRow() : Put the candidate of a row in the solution
+    //
+    //  The row is selected only if its columns are all still present
+    //
+    //  @first : first node of the row
+    //
+    //  @return : true if selected
+    //
+    bool _selectRow(uint16_t first);
+
+    // _coverOthers() : Cover the other columns of a row
+    //
+    //  @node : a node of the row whose column is already covered
+    //
+    void _coverOthers(uint16_t node);
+
+    // _uncoverOthers() : Uncover the other columns of a row
+    //
+    //  @node : a node of the row
+    //
+    void _uncoverOthers(uint16_t node);
+
+    // _chooseColumn() : Column with the fewest rows
+    //
+    //  @return : column index
+    //
+    uint16_t _chooseColumn();
+
+    // _rowCandidate() : Candidate (ie. pos. * VALUE_MAX + value - 1)
+    //                   associated to a node
+    //
+    //  @node : node index
+    //
+    //  @return : index of the candidate
+    //
+    uint16_t _rowCandidate(uint16_t node){
+        return (node - DLX_FIRST_NODE) / DLX_CONSTRAINTS;
+    }
+
+    // Members
+private:
+    uint16_t* links_;   // Memory block for all the nodes
+
+    uint16_t* left_;    // Horizontal links
+    uint16_t* right_;
+    uint16_t* up_;      // Vertical links
+    uint16_t* down_;
+    uint16_t* col_;     // Column of each node
+    uint16_t* size_;    // # of rows in each column
+
+    uint16_t stack_[VALUES_COUNT];  // Rows currently selected
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_DLX_SOLVER_h__
+
+// EOF
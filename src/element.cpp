@@ -8,32 +8,11 @@
 
 #include "element.h"
 
-// Construction
+// Colours of the hypotheses, by index
 //
-element::element(int value){
-    status_ = (EMPTY_VALUE == value)?
-                    STATUS_EMPTY:STATUS_ORIGINAL | STATUS_SET;
-    value_ = value;
-    hypotheseColour_ = HYP_NO_COLOUR; // No hypothese by default
-}
-
-//
-// Overloads
-//
-
-// Assignments
-//
-element& element::operator=(const element& right){
-    status_ = right.status_;
-    value_ = right.value_;
-    hypotheseColour_ = right.hypotheseColour_;
-    return *this;
-}
-
-element& element::operator=(uint8_t right){
-    value_ = right;
-    return *this;
-}
+static const int _hypColours[HYP_COUNT + 1] = {
+    HYP_NO_COLOUR, HYP_COLOUR_YELLOW, HYP_COLOUR_BLUE,
+    HYP_COLOUR_GREEN, HYP_COLOUR_RED};
 
 // setValue() : Set or modify a value
 //
@@ -43,18 +22,14 @@ element& element::operator=(uint8_t right){
 void element::setValue(uint8_t value, bool editMode){
     if (!editMode){
         if (!_isStatusBitSet(STATUS_ORIGINAL)){
-            if (value != EMPTY_VALUE){
-                value_ = value;
-                status_ = STATUS_SET;
-            }
-            else{
-                status_ = STATUS_EMPTY;
-            }
+            grid_->values[index_] = value;
+            grid_->status[index_] =
+                (EMPTY_VALUE == value)?STATUS_EMPTY:STATUS_SET;
         }
     }
     else{
-        value_ = value;
-        status_ = (EMPTY_VALUE == value)?
+        grid_->values[index_] = value;
+        grid_->status[index_] = (EMPTY_VALUE == value)?
                     STATUS_EMPTY : STATUS_SET | STATUS_ORIGINAL;
     }
 }
@@ -64,11 +39,32 @@ void element::setValue(uint8_t value, bool editMode){
 //  @return : previous value
 //
 uint8_t element::empty(){
-    status_ = STATUS_EMPTY;
-    uint8_t value(value_);
-    value_ = EMPTY_VALUE;
-    hypotheseColour_ = HYP_NO_COLOUR;
+    uint8_t value(grid_->values[index_]);
+    grid_->values[index_] = EMPTY_VALUE;
+    grid_->status[index_] = STATUS_EMPTY;
+    grid_->hyps[index_] = HYP_NO_INDEX;
     return value;
 }
 
+// setHypColour() : Change the hypothese's colour
+//
+//  @hypcolour : Colour to use
+//
+void element::setHypColour(int hypColour){
+    uint8_t id(HYP_COUNT);
+    while (id > HYP_NO_INDEX && _hypColours[id] != hypColour){
+        id--;
+    }
+
+    grid_->hyps[index_] = id;   // HYP_NO_INDEX if unknown
+}
+
+// hypColour() : Get the hyp. colour used by the element
+//
+//  @return : Current hyp. colour
+//
+int element::hypColour(){
+    return _hypColours[grid_->hyps[index_]];
+}
+
 // EOF
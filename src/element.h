@@ -25,6 +25,7 @@
 //
 
 #define HYP_COUNT   4       // Max. count of hyp.
+#define HYP_NO_INDEX    0   // Index of "no colour"
 
 #ifdef DEST_CASIO_CALC
 enum HYP_COLOUR{
@@ -40,14 +41,31 @@ enum HYP_COLOUR{
 extern "C" {
 #endif // #ifdef __cplusplus
 
+// Compact storage of a whole grid
+//
+//  Values, status and hypotheses are stored in separate tables,
+//  so the solver can work on the values only.
+//  An empty element always has the EMPTY_VALUE value.
+//
+typedef struct _GRID{
+    uint8_t values[VALUES_COUNT];   // Value of each element
+    uint8_t status[VALUES_COUNT];   // Status bits of each element
+    uint8_t hyps[VALUES_COUNT];     // Index of the hyp. colour (or HYP_NO_INDEX)
+}GRID;
+
 // element - A single sudoku grid element
 //
+//  An element is just a "view" on an element of a GRID
+//
 class element{
 
 public:
 
     // Construction
-    element(int value = EMPTY_VALUE);
+    element(GRID* grid, uint8_t index){
+        grid_ = grid;
+        index_ = index;
+    }
 
     // Destrcution
     ~element(){}
@@ -57,12 +75,15 @@ public:
     //
 
     // Assignments
-    element& operator=(const element& right);
-    element& operator=(uint8_t right);
+    element& operator=(const element& right) = delete;
+    element& operator=(uint8_t right){
+        grid_->values[index_] = right;
+        return *this;
+    }
 
     // Comparison
     bool operator==(uint8_t right){
-        return (value_ == right);
+        return (grid_->values[index_] == right);
     }
 
     //
@@ -79,7 +100,7 @@ public:
     // Access
     //
     uint8_t value(){
-        return (_isStatusBitSet(STATUS_SET)?value_:EMPTY_VALUE);
+        return grid_->values[index_];
     }
 
     // empty() : Empty the element
@@ -97,7 +118,7 @@ public:
     //  @return : element's status
     //
     uint8_t status(){
-        return status_;
+        return grid_->status[index_];
     }
 
     // setStatus() : Set element's status
@@ -105,7 +126,7 @@ public:
     //  @nStatus : element's status
     //
     void setStatus(uint8_t nStatus){
-        status_ = nStatus;
+        grid_->status[index_] = nStatus;
     }
 
     // isEmpty() : Check wether element is empty
@@ -113,7 +134,7 @@ public:
     //  @return : true if is element empty
     //
     bool isEmpty(){
-        return (STATUS_EMPTY == status_);
+        return (STATUS_EMPTY == status());
     }
 
     // isOriginal() : Is the element original
@@ -142,7 +163,7 @@ public:
     //  @return : true if element's value is changeable
     //
     bool isChangeable(){
-        return (STATUS_EMPTY == status_ || STATUS_SET == status_);
+        return (status() <= STATUS_SET);
     }
 
     //
@@ -153,17 +174,13 @@ public:
     //
     //  @hypcolour : Colour to use
     //
-    void setHypColour(int hypColour){
-        hypotheseColour_ = hypColour;
-    }
+    void setHypColour(int hypColour);
 
     // hypColour() : Get the hyp. colour used by the element
     //
     //  @return : Current hyp. colour
     //
-    int hypColour(){
-        return hypotheseColour_;
-    }
+    int hypColour();
 
 private:
         // _isStatusBitSet : Check wether a bit is set
@@ -173,14 +190,13 @@ private:
         // @return : true if the bit is present in the object's status
         //
         bool _isStatusBitSet(int singleBit){
-            return ((status_ & singleBit) == singleBit);
+            return ((status() & singleBit) == singleBit);
         }
 
     // Members
 private:
-        uint8_t     status_;
-        uint8_t     value_;
-        int         hypotheseColour_;   // Colour of hypothese
+        GRID*       grid_;
+        uint8_t     index_;     // Index in the grid
 }; // class element
 
 #ifdef __cplusplus
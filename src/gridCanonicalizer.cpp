@@ -0,0 +1,337 @@
+//----------------------------------------------------------------------
+//--
+//--    gridCanonicalizer.cpp
+//--
+//--        Implementation of gridCanonicalizer object - Canonical form
+//--        (minlex) of a grid and its hash
+//--
+//----------------------------------------------------------------------
+
+#include "gridCanonicalizer.h"
+
+#define ORDERS_COUNT    6   // # of orders of the 3 items of a block
+
+// All the orders of 3 items
+//
+static const uint8_t __orders[ORDERS_COUNT][TRANSFORM_BLOCK_SIZE] = {
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+};
+
+// MurmurHash3 constants
+//
+#define HASH_C1     0x239B961B
+#define HASH_C2     0xAB0E9789
+#define HASH_C3     0x38B34AE5
+#define HASH_C4     0xA1E38B93
+
+// __rotl() : Rotate bits to the left
+//
+static inline uint32_t __rotl(uint32_t value, uint8_t count){
+    return (value << count) | (value >> (32 - count));
+}
+
+// __fmix() : Final mix of the bits of a 32 bits number
+//
+static uint32_t __fmix(uint32_t value){
+    value ^= (value >> 16);
+    value *= 0x85EBCA6B;
+    value ^= (value >> 13);
+    value *= 0xC2B2AE35;
+    value ^= (value >> 16);
+    return value;
+}
+
+// canonicalize() : Canonical form of a grid or a puzzle
+//
+//  @values : values of the grid (EMPTY_VALUE for empty elements)
+//  @canonical : will receive the canonical form. Can be @values
+//
+//  @return : false if a value is invalid
+//
+bool gridCanonicalizer::canonicalize(const uint8_t* values,
+                                    uint8_t* canonical){
+    if (!values || !canonical){
+        return false;
+    }
+
+    uint8_t index, transposed[VALUES_COUNT];
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        if (values[index] > VALUE_MAX){
+            return false;
+        }
+
+        transposed[index] = values[(index % ROW_COUNT) * ROW_COUNT
+                                    + index / ROW_COUNT];
+    }
+
+    bestSize_ = 0;
+    for (uint8_t pass(0); pass < 2; pass++){
+        source_ = (pass?transposed:values);
+
+        // Empty lines and columns
+        emptyLines_ = emptyCols_ = (1 << LINE_COUNT) - 1;
+        for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+            if (source_[index]){
+                emptyLines_ &= ~(1 << (index / ROW_COUNT));
+                emptyCols_ &= ~(1 << (index % ROW_COUNT));
+            }
+        }
+
+        usedLines_ = 0;
+        for (firstLine_ = 0; firstLine_ < LINE_COUNT; firstLine_++){
+            if (_isEmptyTwin(firstLine_)){
+                continue;
+            }
+
+            memset(labels_, 0, sizeof(labels_));
+            nextLabel_ = VALUE_MIN;
+            usedStacks_ = 0;
+            _searchColumns(0);
+        }
+    }
+
+    memcpy(canonical, best_, VALUES_COUNT);
+    return true;
+}
+
+// key() : Hash of the canonical form of a grid
+//
+//  @values : values of the grid
+//  @hash : will receive the hash
+//  @canonical : will receive the canonical form (can be NULL)
+//
+//  @return : false if a value is invalid
+//
+bool gridCanonicalizer::key(const uint8_t* values, GRID_HASH& hash,
+                            uint8_t* canonical){
+    uint8_t form[VALUES_COUNT];
+    if (!canonicalize(values, form)){
+        return false;
+    }
+
+    gridCanonicalizer::hash(form, hash);
+    if (canonical){
+        memcpy(canonical, form, VALUES_COUNT);
+    }
+
+    return true;
+}
+
+// hash() : 128 bits hash of a grid (MurmurHash3)
+//
+//  @values : values of the grid
+//  @hash : will receive the hash
+//
+void gridCanonicalizer::hash(const uint8_t* values, GRID_HASH& hash){
+    static const uint32_t consts[GRID_HASH_WORDS] = {
+        HASH_C1, HASH_C2, HASH_C3, HASH_C4
+    };
+    static const uint8_t rotations[GRID_HASH_WORDS] = {15, 16, 17, 18};
+    static const uint8_t mixes[GRID_HASH_WORDS] = {19, 17, 15, 13};
+    static const uint32_t adds[GRID_HASH_WORDS] = {
+        0x561CCD1B, 0x0BCAA747, 0x96CD1C35, 0x32AC3B17
+    };
+
+    uint32_t* h(hash.words);
+    uint32_t k;
+    uint8_t index, word, blocks(VALUES_COUNT / (4 * GRID_HASH_WORDS));
+    memset(h, 0, sizeof(hash.words));
+
+    // Blocks of 16 bytes
+    const uint8_t* data(values);
+    for (index = 0; index < blocks; index++){
+        for (word = 0; word < GRID_HASH_WORDS; word++){
+            k = data[0] | (data[1] << 8) | (data[2] << 16)
+                | ((uint32_t)data[3] << 24);
+            data += 4;
+
+            k *= consts[word];
+            k = __rotl(k, rotations[word]);
+            k *= consts[(word + 1) % GRID_HASH_WORDS];
+            h[word] ^= k;
+
+            h[word] = __rotl(h[word], mixes[word]);
+            h[word] += h[(word + 1) % GRID_HASH_WORDS];
+            h[word] = h[word] * 5 + adds[word];
+        }
+    }
+
+    // Tail (less than 4 bytes : only in the first word)
+    uint8_t tail(VALUES_COUNT % (4 * GRID_HASH_WORDS));
+    if (tail){
+        for (k = 0, index = 0; index < tail; index++){
+            k ^= (uint32_t)data[index] << (8 * index);
+        }
+
+        k *= consts[0];
+        k = __rotl(k, rotations[0]);
+        k *= consts[1];
+        h[0] ^= k;
+    }
+
+    // Finalization
+    for (word = 0; word < GRID_HASH_WORDS; word++){
+        h[word] ^= VALUES_COUNT;
+    }
+
+    h[0] += h[1] + h[2] + h[3];
+    h[1] += h[0]; h[2] += h[0]; h[3] += h[0];
+
+    for (word = 0; word < GRID_HASH_WORDS; word++){
+        h[word] = __fmix(h[word]);
+    }
+
+    h[0] += h[1] + h[2] + h[3];
+    h[1] += h[0]; h[2] += h[0]; h[3] += h[0];
+}
+
+//
+// Internal methods
+//
+
+// _searchColumns() : Choose the columns of a stack and the following
+//                    ones, for the first line
+//
+//  @stack : index of the stack to fill
+//
+void gridCanonicalizer::_searchColumns(uint8_t stack){
+    if (stack >= TRANSFORM_BLOCK_COUNT){
+        // Columns are set : choose the other lines
+        usedLines_ = (1 << firstLine_);
+        _searchLines(1, firstLine_ / TRANSFORM_BLOCK_SIZE);
+        return;
+    }
+
+    uint8_t labels[VALUE_MAX + 1], nextLabel, source, order, row;
+    uint8_t first(stack * TRANSFORM_BLOCK_SIZE);
+    for (source = 0; source < TRANSFORM_BLOCK_COUNT; source++){
+        if (usedStacks_ & (1 << source)){
+            continue;
+        }
+
+        usedStacks_ |= (1 << source);
+        for (order = 0; order < ORDERS_COUNT; order++){
+            uint8_t lastEmpty(0);
+            bool twin(false);
+            for (row = 0; row < TRANSFORM_BLOCK_SIZE; row++){
+                cols_[first + row] = source * TRANSFORM_BLOCK_SIZE
+                                        + __orders[order][row];
+
+                // Empty columns are kept in their order
+                if (emptyCols_ & (1 << cols_[first + row])){
+                    twin |= (cols_[first + row] < lastEmpty);
+                    lastEmpty = cols_[first + row];
+                }
+            }
+
+            if (twin){
+                continue;   // Same as another order
+            }
+
+            memcpy(labels, labels_, sizeof(labels));
+            nextLabel = nextLabel_;
+
+            if (_relabel(first, firstLine_, first, TRANSFORM_BLOCK_SIZE)){
+                _searchColumns(stack + 1);
+            }
+
+            memcpy(labels_, labels, sizeof(labels));
+            nextLabel_ = nextLabel;
+        }
+        usedStacks_ &= ~(1 << source);
+    }
+}
+
+// _searchLines() : Choose the line at a position and the following ones
+//
+//  @level : index of the line to choose
+//  @band : band of the previous line
+//
+void gridCanonicalizer::_searchLines(uint8_t level, uint8_t band){
+    if (level >= LINE_COUNT){
+        return;
+    }
+
+    // First line of a band : any line of an unused band
+    uint8_t first, last;
+    if (level % TRANSFORM_BLOCK_SIZE){
+        first = band * TRANSFORM_BLOCK_SIZE;
+        last = first + TRANSFORM_BLOCK_SIZE;
+    }
+    else{
+        first = 0;
+        last = LINE_COUNT;
+    }
+
+    uint8_t labels[VALUE_MAX + 1], nextLabel, id;
+    for (id = first; id < last; id++){
+        if ((usedLines_ & (1 << id)) ||
+            (!(level % TRANSFORM_BLOCK_SIZE) &&
+            (usedLines_ & (((1 << TRANSFORM_BLOCK_SIZE) - 1)
+                            << (id - id % TRANSFORM_BLOCK_SIZE))))){
+            continue;   // Line or band already used
+        }
+
+        if (_isEmptyTwin(id)){
+            continue;   // Same as another empty line
+        }
+
+        memcpy(labels, labels_, sizeof(labels));
+        nextLabel = nextLabel_;
+
+        if (_relabel(level * ROW_COUNT, id, 0, ROW_COUNT)){
+            usedLines_ |= (1 << id);
+            _searchLines(level + 1, id / TRANSFORM_BLOCK_SIZE);
+            usedLines_ &= ~(1 << id);
+        }
+
+        memcpy(labels_, labels, sizeof(labels));
+        nextLabel_ = nextLabel;
+    }
+}
+
+// _relabel() : Relabel values and compare them with the best form
+//
+//  The values of a smaller prefix replace those of the best form
+//
+//  @pos : position of the first value in the form
+//  @line : source line
+//  @first : first row
+//  @count : # of values
+//
+//  @return : false if greater than the best form
+//
+bool gridCanonicalizer::_relabel(uint8_t pos, uint8_t line, uint8_t first,
+                                uint8_t count){
+    const uint8_t* source(source_ + line * ROW_COUNT);
+    uint8_t value;
+    bool smaller(false);
+    for (uint8_t row(first); row < first + count; row++, pos++){
+        if ((value = source[cols_[row]]) && !labels_[value]){
+            labels_[value] = nextLabel_++;
+        }
+
+        value = labels_[value];
+        if (!smaller){
+            if (pos < bestSize_){
+                if (value > best_[pos]){
+                    return false;   // Greater
+                }
+
+                smaller = (value < best_[pos]);
+            }
+            else{
+                smaller = true;
+            }
+        }
+
+        if (smaller){
+            best_[pos] = value;
+            bestSize_ = pos + 1;
+        }
+    }
+
+    return true;
+}
+
+// EOF
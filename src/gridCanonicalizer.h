@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------
+//--
+//--    gridCanonicalizer.h
+//--
+//--        Definition of gridCanonicalizer object - Canonical form
+//--        (minlex) of a grid and its hash
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_GRID_CANONICALIZER_h__
+#define __S_SOLVER_GRID_CANONICALIZER_h__    1
+
+#include "gridTransform.h"
+
+#define GRID_HASH_WORDS     4   // 128 bits
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+// Hash of a grid
+//
+typedef struct _GRID_HASH{
+    uint32_t words[GRID_HASH_WORDS];
+}GRID_HASH;
+
+//   gridCanonicalizer : Canonical form of a grid
+//
+//      The canonical form is the smallest grid (read line by line, empty
+//      elements first) among all the grids obtained with a gridTransform.
+//      Two grids have the same canonical form if and only if one is a
+//      transformation of the other.
+//
+//      For each transposition and each first line, the columns are
+//      chosen one stack at a time, then the other lines one at a time.
+//      Values are relabeled in order of appearance. A choice that gives
+//      a greater prefix than the best form found so far is dropped with
+//      all its followers. Empty lines of a band (and empty columns of
+//      a stack) can be swapped without changing the grid : only one of
+//      their orders is tried.
+//
+class gridCanonicalizer{
+public:
+
+    // Construction
+    gridCanonicalizer(){}
+    gridCanonicalizer(const gridCanonicalizer&) = delete;
+
+    // Destruction
+    ~gridCanonicalizer(){}
+
+    // canonicalize() : Canonical form of a grid or a puzzle
+    //
+    //  @values : values of the grid (EMPTY_VALUE for empty elements)
+    //  @canonical : will receive the canonical form. Can be @values
+    //
+    //  @return : false if a value is invalid
+    //
+    bool canonicalize(const uint8_t* values, uint8_t* canonical);
+
+    // key() : Hash of the canonical form of a grid
+    //
+    //  @values : values of the grid
+    //  @hash : will receive the hash
+    //  @canonical : will receive the canonical form (can be NULL)
+    //
+    //  @return : false if a value is invalid
+    //
+    bool key(const uint8_t* values, GRID_HASH& hash,
+                uint8_t* canonical = NULL);
+
+    // hash() : 128 bits hash of a grid (MurmurHash3)
+    //
+    //  @values : values of the grid
+    //  @hash : will receive the hash
+    //
+    static void hash(const uint8_t* values, GRID_HASH& hash);
+
+    // sameHash() : Are 2 hashes equal ?
+    //
+    //  @first, @second : hashes to compare
+    //
+    //  @return : true if equal
+    //
+    static bool sameHash(const GRID_HASH& first, const GRID_HASH& second){
+        return (0 == memcmp(first.words, second.words, sizeof(first.words)));
+    }
+
+private:
+
+    // _searchColumns() : Choose the columns of a stack and the following
+    //                    ones, for the first line
+    //
+    //  @stack : index of the stack to fill
+    //
+    void _searchColumns(uint8_t stack);
+
+    // _searchLines() : Choose the line at a position and the following ones
+    //
+    //  @level : index of the line to choose
+    //  @band : band of the previous line
+    //
+    void _searchLines(uint8_t level, uint8_t band);
+
+    // _isEmptyTwin() : Is a line empty, with an unused empty line
+    //                  before it in its band ?
+    //
+    //  @line : index of the line
+    //
+    //  @return : true if @line can be skipped
+    //
+    bool _isEmptyTwin(uint8_t line){
+        uint16_t before(((1 << line) - 1)
+                    & ~((1 << (line - line % TRANSFORM_BLOCK_SIZE)) - 1));
+        return ((emptyLines_ & (1 << line))
+                && (emptyLines_ & before & ~usedLines_));
+    }
+
+    // _relabel() : Relabel values and compare them with the best form
+    //
+    //  @pos : position of the first value in the form
+    //  @line : source line
+    //  @first : first row
+    //  @count : # of values
+    //
+    //  @return : false if greater than the best form
+    //
+    bool _relabel(uint8_t pos, uint8_t line, uint8_t first, uint8_t count);
+
+    // Members
+private:
+    const uint8_t* source_;         // Grid (transposed or not)
+    uint8_t cols_[ROW_COUNT];       // Source column of each column
+    uint8_t usedStacks_;            // Stacks already chosen (bit mask)
+    uint16_t usedLines_;            // Lines already chosen (bit mask)
+    uint8_t firstLine_;             // Source of the first line
+    uint16_t emptyLines_;           // Lines with no value (bit mask)
+    uint16_t emptyCols_;            // Columns with no value (bit mask)
+
+    uint8_t labels_[VALUE_MAX + 1]; // New value of each value (0 if none yet)
+    uint8_t nextLabel_;
+
+    uint8_t best_[VALUES_COUNT];    // Smallest form found so far
+    uint8_t bestSize_;              // # of values set in best_
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_GRID_CANONICALIZER_h__
+
+// EOF
@@ -0,0 +1,253 @@
+//----------------------------------------------------------------------
+//--
+//--    gridPool.cpp
+//--
+//--        Implementation of gridPool object - Grids created in advance,
+//--        for each complexity level
+//--
+//----------------------------------------------------------------------
+
+#include "gridPool.h"
+
+// Complexity of each level
+//
+static const uint8_t __complexities[POOL_LEVELS] = {
+    COMPLEXITY_EASY, COMPLEXITY_MEDIUM, COMPLEXITY_HARD
+};
+
+// Construction
+//
+gridPool::gridPool(){
+    memset(levels_, 0, sizeof(levels_));
+    memset(misses_, 0, sizeof(misses_));
+    modified_ = false;
+}
+
+// load() : Load the pool file
+//
+//  @return : 0 on success or an error code
+//
+int gridPool::load(){
+#ifdef DEST_CASIO_CALC
+    uint16_t fName[BFILE_MAX_PATH + 1];
+#else
+    char fName[BFILE_MAX_PATH + 1];
+#endif // DEST_CASIO_CALC
+    _fileName(fName);
+
+    memset(levels_, 0, sizeof(levels_));
+    modified_ = false;
+
+    bFile iFile;
+    if (!iFile.open(fName, BFile_ReadOnly)){
+        return FILE_IO_ERROR;   // No pool yet
+    }
+
+    int size(iFile.read(levels_, sizeof(levels_), 0));
+    iFile.close();
+
+    // Check the content
+    bool valid((int)sizeof(levels_) == size);
+    for (uint8_t level(0); valid && level < POOL_LEVELS; level++){
+        valid = (levels_[level].count <= POOL_CAPACITY);
+    }
+
+    if (!valid){
+        memset(levels_, 0, sizeof(levels_));
+        return FILE_INVALID_FILESIZE;
+    }
+
+    return FILE_NO_ERROR;
+}
+
+// save() : Save the pool file, if it has changed
+//
+//  @return : 0 on success or an error code
+//
+int gridPool::save(){
+    if (!modified_){
+        return FILE_NO_ERROR;
+    }
+
+#ifdef DEST_CASIO_CALC
+    uint16_t fName[BFILE_MAX_PATH + 1];
+#else
+    char fName[BFILE_MAX_PATH + 1];
+#endif // DEST_CASIO_CALC
+    _fileName(fName);
+
+    bFile oFile;
+    int fSize(sizeof(levels_));
+    oFile.remove(fName);    // Remove the file (if already exist)
+
+    if (!oFile.createEx(fName, BFile_File, &fSize, BFile_WriteOnly)){
+        return oFile.getLastError();
+    }
+
+    bool done(oFile.write(levels_, sizeof(levels_)));
+    int error(oFile.getLastError());
+    oFile.close();
+
+    if (done){
+        modified_ = false;
+        return FILE_NO_ERROR;
+    }
+
+    return error;
+}
+
+// full() : Are all the levels full ?
+//
+//  @return : true if no grid can be added
+//
+bool gridPool::full(){
+    for (uint8_t level(0); level < POOL_LEVELS; level++){
+        if (levels_[level].count < POOL_CAPACITY){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// pop() : Take a grid from the pool
+//
+//  @complexity : complexity level
+//  @grid : will receive the grid, with "original" values
+//
+//  @return : false if no grid is ready for this level
+//
+bool gridPool::pop(uint8_t complexity, GRID* grid){
+    int8_t level(_level(complexity));
+    if (level < 0 || !levels_[level].count || !grid){
+        return false;
+    }
+
+    // Unpack the last grid
+    memset(grid, 0, sizeof(GRID));
+    const uint8_t* packed(levels_[level].grids[--levels_[level].count]);
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        grid->values[index] = ((index % 2)?
+                        (packed[index / 2] >> 4):(packed[index / 2] & 0x0F));
+        if (grid->values[index]){
+            grid->status[index] = STATUS_ORIGINAL | STATUS_SET;
+        }
+    }
+
+    modified_ = true;
+    return true;
+}
+
+// push() : Add a grid to the pool
+//
+//  @complexity : complexity level
+//  @values : values of the grid
+//
+//  @return : false if the level is full
+//
+bool gridPool::push(uint8_t complexity, const uint8_t* values){
+    int8_t level(_level(complexity));
+    if (level < 0 || levels_[level].count >= POOL_CAPACITY){
+        return false;
+    }
+
+    // Pack the values
+    uint8_t* packed(levels_[level].grids[levels_[level].count++]);
+    memset(packed, 0, POOL_GRID_SIZE);
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        packed[index / 2] |= ((index % 2)?(values[index] << 4):values[index]);
+    }
+
+    modified_ = true;
+    return true;
+}
+
+// refill() : Create a grid for the level with the fewest grids
+//
+//  The levels skipped after too many misses are ignored
+//
+//  @generator : sudoku object used to create the grid
+//  @budget : limits of the creation
+//
+//  @return : true if a grid has been added
+//
+bool gridPool::refill(sudoku& generator, SEARCH_BUDGET& budget){
+    int8_t level(_nextLevel());
+    if (level < 0){
+        return false;   // Already full
+    }
+
+    if (generator.create(__complexities[level], budget) < 0){
+        if (misses_[level] < POOL_MAX_MISSES){
+            misses_[level]++;   // Stopped (or error)
+        }
+        return false;
+    }
+
+    misses_[level] = 0;
+
+    GRID grid;
+    generator.getElements(&grid);
+    return push(__complexities[level], grid.values);
+}
+
+//
+// Internal methods
+//
+
+// _level() : Index of a complexity level
+//
+//  @complexity : complexity level
+//
+//  @return : index or -1 if unknown level
+//
+int8_t gridPool::_level(uint8_t complexity){
+    for (uint8_t level(0); level < POOL_LEVELS; level++){
+        if (__complexities[level] == complexity){
+            return level;
+        }
+    }
+
+    return -1;
+}
+
+// _nextLevel() : Level to refill
+//
+//  When all the levels left are skipped, they are all tried again
+//
+//  @return : index of the level with the fewest grids and not
+//          skipped, or -1 if all the levels are full
+//
+int8_t gridPool::_nextLevel(){
+    int8_t level(-1);
+    for (uint8_t pass(0); -1 == level && pass < 2; pass++){
+        for (uint8_t other(0); other < POOL_LEVELS; other++){
+            if (levels_[other].count < POOL_CAPACITY
+                && misses_[other] < POOL_MAX_MISSES
+                && (-1 == level
+                    || levels_[other].count < levels_[level].count)){
+                level = other;
+            }
+        }
+
+        if (-1 == level){
+            memset(misses_, 0, sizeof(misses_));    // Try them all again
+        }
+    }
+
+    return level;
+}
+
+// _fileName() : Full name of the pool file
+//
+//  @fName : will receive the name
+//
+void gridPool::_fileName(FONTCHARACTER fName){
+    char name[BFILE_MAX_PATH + 1];
+    strcpy(name, GRIDS_FOLDER);
+    strcat(name, PATH_SEPARATOR);
+    strcat(name, POOL_FILE_NAME);
+    bFile::FC_str2FC(name, fName);
+}
+
+// EOF
@@ -0,0 +1,160 @@
+//----------------------------------------------------------------------
+//--
+//--    gridPool.h
+//--
+//--        Definition of gridPool object - Grids created in advance,
+//--        for each complexity level
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_GRID_POOL_h__
+#define __S_SOLVER_GRID_POOL_h__    1
+
+#include "sudoku.h"
+
+// Pool file (in GRIDS_FOLDER)
+//  The extension isn't GRID_FILE_EXT : the file is not listed as a grid
+//
+#define POOL_FILE_NAME      "pool.bin"
+
+// Dimensions
+//
+#define POOL_LEVELS         3       // EASY, MEDIUM and HARD
+#define POOL_CAPACITY       8       // # of grids per level
+#define POOL_GRID_SIZE      ((VALUES_COUNT + 1) / 2)    // 2 values per byte
+
+// Refill
+//
+#define POOL_IDLE_DELAY     3       // Time (in s.) without key before refilling
+#define POOL_SLICE_DURATION 2       // Max. duration (in s.) of a refill
+#define POOL_MAX_MISSES     3       // Slices over before a level is skipped
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+// Grids of a level
+//
+typedef struct _POOL_LEVEL{
+    uint8_t count;      // # of grids
+    uint8_t reserved;   // The size of the file must be even
+    uint8_t grids[POOL_CAPACITY][POOL_GRID_SIZE];
+}POOL_LEVEL;
+
+//   gridPool : Grids created in advance
+//
+//      Getting a new grid is instantaneous : a grid is taken from the
+//      pool, which is refilled when the calculator is idle.
+//      The pool is kept in a file between sessions.
+//
+//      Each refill creates a grid from scratch, within one slice. The
+//      generation is not resumed : a level whose creation has been
+//      stopped POOL_MAX_MISSES times in a row is skipped until the
+//      other levels are full or skipped, so a HARD grid too slow to
+//      create never prevents the other levels from being refilled.
+//
+class gridPool{
+public:
+
+    // Construction
+    gridPool();
+    gridPool(const gridPool&) = delete;
+
+    // Destruction
+    ~gridPool(){}
+
+    // load() : Load the pool file
+    //
+    //  @return : 0 on success or an error code
+    //
+    int load();
+
+    // save() : Save the pool file, if it has changed
+    //
+    //  @return : 0 on success or an error code
+    //
+    int save();
+
+    // count() : # of grids ready for a complexity level
+    //
+    //  @complexity : complexity level
+    //
+    //  @return : # of grids
+    //
+    uint8_t count(uint8_t complexity){
+        int8_t level(_level(complexity));
+        return ((level < 0)?0:levels_[level].count);
+    }
+
+    // full() : Are all the levels full ?
+    //
+    //  @return : true if no grid can be added
+    //
+    bool full();
+
+    // pop() : Take a grid from the pool
+    //
+    //  @complexity : complexity level
+    //  @grid : will receive the grid, with "original" values
+    //
+    //  @return : false if no grid is ready for this level
+    //
+    bool pop(uint8_t complexity, GRID* grid);
+
+    // push() : Add a grid to the pool
+    //
+    //  @complexity : complexity level
+    //  @values : values of the grid
+    //
+    //  @return : false if the level is full
+    //
+    bool push(uint8_t complexity, const uint8_t* values);
+
+    // refill() : Create a grid for the level with the fewest grids
+    //
+    //  The levels skipped after too many misses are ignored
+    //
+    //  @generator : sudoku object used to create the grid
+    //  @budget : limits of the creation
+    //
+    //  @return : true if a grid has been added
+    //
+    bool refill(sudoku& generator, SEARCH_BUDGET& budget);
+
+private:
+
+    // _level() : Index of a complexity level
+    //
+    //  @complexity : complexity level
+    //
+    //  @return : index or -1 if unknown level
+    //
+    int8_t _level(uint8_t complexity);
+
+    // _nextLevel() : Level to refill
+    //
+    //  @return : index of the level with the fewest grids and not
+    //          skipped, or -1 if all the levels are full
+    //
+    int8_t _nextLevel();
+
+    // _fileName() : Full name of the pool file
+    //
+    //  @fName : will receive the name
+    //
+    void _fileName(FONTCHARACTER fName);
+
+    // Members
+private:
+    POOL_LEVEL levels_[POOL_LEVELS];
+    bool modified_;     // Must be saved ?
+    uint8_t misses_[POOL_LEVELS];   // # of slices over in a row
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_GRID_POOL_h__
+
+// EOF
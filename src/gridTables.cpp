@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------
+//--
+//--    gridTables.cpp
+//--
+//--        Lookup tables of the grid : line, row and tinySquare of
+//--        each element, elements of each unit and peers of each
+//--        element
+//--
+//----------------------------------------------------------------------
+
+#include "gridTables.h"
+
+// __buildGridTables() : Fill all the lookup tables
+//
+//  @return : the tables
+//
+constexpr GRID_TABLES __buildGridTables(){
+    GRID_TABLES tables{};
+    uint8_t index(0), other(0), line(0), row(0), square(0), count(0);
+    uint8_t lineCount[LINE_COUNT]{}, rowCount[ROW_COUNT]{};
+    uint8_t squareCount[TINY_COUNT]{};
+
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        line = index / ROW_COUNT;
+        row = index % ROW_COUNT;
+        square = TINY_ROW_COUNT * (line / TINY_LINE_COUNT)
+                    + row / TINY_ROW_COUNT;
+
+        tables.line[index] = line;
+        tables.row[index] = row;
+        tables.square[index] = square;
+
+        // Elements are added to their units in index order
+        tables.units[UNIT_LINE + line][lineCount[line]++] = index;
+        tables.units[UNIT_ROW + row][rowCount[row]++] = index;
+        tables.units[UNIT_SQUARE + square][squareCount[square]++] = index;
+    }
+
+    // Peers
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        count = 0;
+        for (other = INDEX_MIN; other <= INDEX_MAX; other++){
+            if (other != index &&
+                (tables.line[other] == tables.line[index]
+                || tables.row[other] == tables.row[index]
+                || tables.square[other] == tables.square[index])){
+                tables.peers[index][count++] = other;
+            }
+        }
+    }
+
+    return tables;
+}
+
+constexpr GRID_TABLES gGridTables = __buildGridTables();
+
+// EOF
@@ -0,0 +1,53 @@
+//----------------------------------------------------------------------
+//--
+//--    gridTables.h
+//--
+//--        Lookup tables of the grid : line, row and tinySquare of
+//--        each element, elements of each unit and peers of each
+//--        element
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_GRID_TABLES_h__
+#define __S_SOLVER_GRID_TABLES_h__    1
+
+#include "consts.h"
+#include "tinySquare.h"
+
+// Units : lines, rows and tinySquares
+//
+#define UNIT_COUNT  (LINE_COUNT + ROW_COUNT + TINY_COUNT)
+#define UNIT_LINE   0                           // First line ID
+#define UNIT_ROW    (UNIT_LINE + LINE_COUNT)    // First row ID
+#define UNIT_SQUARE (UNIT_ROW + ROW_COUNT)      // First tinySquare ID
+
+// # of elements sharing a unit with an element (20)
+//
+#define PEER_COUNT  (2 * (VALUE_MAX - 1) \
+                    + (TINY_LINE_COUNT - 1) * (TINY_ROW_COUNT - 1))
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+// All the tables
+//
+typedef struct _GRID_TABLES{
+    uint8_t line[VALUES_COUNT];         // Line of each element
+    uint8_t row[VALUES_COUNT];          // Row of each element
+    uint8_t square[VALUES_COUNT];       // tinySquare of each element
+    uint8_t units[UNIT_COUNT][VALUE_MAX];       // Elements of each unit
+    uint8_t peers[VALUES_COUNT][PEER_COUNT];    // Peers of each element
+}GRID_TABLES;
+
+// Tables are generated at compile time
+//
+extern const GRID_TABLES gGridTables;
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_GRID_TABLES_h__
+
+// EOF
@@ -0,0 +1,314 @@
+//----------------------------------------------------------------------
+//--
+//--    gridTransform.cpp
+//--
+//--        Implementation of gridTransform object - Transformation of a
+//--        grid that keeps it valid (and keeps its # of solutions)
+//--
+//----------------------------------------------------------------------
+
+#include "gridTransform.h"
+
+// identity() : Reset to the transformation that changes nothing
+//
+void gridTransform::identity(){
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        gather_[index] = index;
+    }
+
+    for (uint8_t value(EMPTY_VALUE); value <= VALUE_MAX; value++){
+        values_[value] = value;     // EMPTY_VALUE is left unchanged
+    }
+}
+
+// randomize() : Choose a random transformation
+//
+//  All the transformations have the same probability
+//
+//  @random : generator of the random numbers
+//
+void gridTransform::randomize(randomGenerator& random){
+    identity();
+
+    uint8_t order[VALUE_MAX], block;
+    random.order(order, VALUE_MAX);
+    for (block = 0; block < VALUE_MAX; block++){
+        order[block] += VALUE_MIN;
+    }
+    relabel(order);
+
+    random.order(order, TRANSFORM_BLOCK_COUNT);
+    permuteBands(order);
+    random.order(order, TRANSFORM_BLOCK_COUNT);
+    permuteStacks(order);
+
+    for (block = 0; block < TRANSFORM_BLOCK_COUNT; block++){
+        random.order(order, TRANSFORM_BLOCK_SIZE);
+        permuteLines(block, order);
+        random.order(order, TRANSFORM_BLOCK_SIZE);
+        permuteRows(block, order);
+    }
+
+    if (random.below(2)){
+        transpose();
+    }
+}
+
+// relabel() : Change the values
+//
+//  @values : new value of each value (values[0] for VALUE_MIN)
+//
+//  @return : false if @values is not a permutation
+//
+bool gridTransform::relabel(const uint8_t* values){
+    uint8_t value, order[VALUE_MAX];
+    for (value = 0; value < VALUE_MAX; value++){
+        if (!values || values[value] < VALUE_MIN){
+            return false;
+        }
+
+        order[value] = values[value] - VALUE_MIN;
+    }
+
+    if (!_isPermutation(order, VALUE_MAX)){
+        return false;
+    }
+
+    for (value = VALUE_MIN; value <= VALUE_MAX; value++){
+        values_[value] = values[values_[value] - VALUE_MIN];
+    }
+
+    return true;
+}
+
+// permuteBands() : Change the order of the bands
+//
+//  @order : source band of each band
+//
+//  @return : false if @order is not a permutation
+//
+bool gridTransform::permuteBands(const uint8_t* order){
+    if (!order || !_isPermutation(order, TRANSFORM_BLOCK_COUNT)){
+        return false;
+    }
+
+    uint8_t lines[LINE_COUNT];
+    for (uint8_t line(0); line < LINE_COUNT; line++){
+        lines[line] = order[line / TRANSFORM_BLOCK_SIZE] * TRANSFORM_BLOCK_SIZE
+                        + line % TRANSFORM_BLOCK_SIZE;
+    }
+
+    _permuteLines(lines);
+    return true;
+}
+
+// permuteStacks() : Change the order of the stacks
+//
+//  @order : source stack of each stack
+//
+//  @return : false if @order is not a permutation
+//
+bool gridTransform::permuteStacks(const uint8_t* order){
+    if (!order || !_isPermutation(order, TRANSFORM_BLOCK_COUNT)){
+        return false;
+    }
+
+    uint8_t rows[ROW_COUNT];
+    for (uint8_t row(0); row < ROW_COUNT; row++){
+        rows[row] = order[row / TRANSFORM_BLOCK_SIZE] * TRANSFORM_BLOCK_SIZE
+                        + row % TRANSFORM_BLOCK_SIZE;
+    }
+
+    _permuteRows(rows);
+    return true;
+}
+
+// permuteLines() : Change the order of the lines in a band
+//
+//  @band : index of the band
+//  @order : source line (in the band) of each line
+//
+//  @return : false if invalid parameters
+//
+bool gridTransform::permuteLines(uint8_t band, const uint8_t* order){
+    if (band >= TRANSFORM_BLOCK_COUNT || !order
+        || !_isPermutation(order, TRANSFORM_BLOCK_SIZE)){
+        return false;
+    }
+
+    uint8_t lines[LINE_COUNT], line;
+    for (line = 0; line < LINE_COUNT; line++){
+        lines[line] = line;
+    }
+
+    for (line = 0; line < TRANSFORM_BLOCK_SIZE; line++){
+        lines[band * TRANSFORM_BLOCK_SIZE + line] =
+                        band * TRANSFORM_BLOCK_SIZE + order[line];
+    }
+
+    _permuteLines(lines);
+    return true;
+}
+
+// permuteRows() : Change the order of the rows in a stack
+//
+//  @stack : index of the stack
+//  @order : source row (in the stack) of each row
+//
+//  @return : false if invalid parameters
+//
+bool gridTransform::permuteRows(uint8_t stack, const uint8_t* order){
+    if (stack >= TRANSFORM_BLOCK_COUNT || !order
+        || !_isPermutation(order, TRANSFORM_BLOCK_SIZE)){
+        return false;
+    }
+
+    uint8_t rows[ROW_COUNT], row;
+    for (row = 0; row < ROW_COUNT; row++){
+        rows[row] = row;
+    }
+
+    for (row = 0; row < TRANSFORM_BLOCK_SIZE; row++){
+        rows[stack * TRANSFORM_BLOCK_SIZE + row] =
+                        stack * TRANSFORM_BLOCK_SIZE + order[row];
+    }
+
+    _permuteRows(rows);
+    return true;
+}
+
+// transpose() : Swap lines and rows
+//
+void gridTransform::transpose(){
+    uint8_t swap;
+    for (uint8_t line(1); line < LINE_COUNT; line++){
+        for (uint8_t row(0); row < line; row++){
+            swap = gather_[line * ROW_COUNT + row];
+            gather_[line * ROW_COUNT + row] = gather_[row * ROW_COUNT + line];
+            gather_[row * ROW_COUNT + line] = swap;
+        }
+    }
+}
+
+// compose() : Append another transformation
+//
+//  @next : transformation applied after this one
+//
+void gridTransform::compose(const gridTransform& next){
+    uint8_t gather[VALUES_COUNT];
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        gather[index] = gather_[next.gather_[index]];
+    }
+    memcpy(gather_, gather, VALUES_COUNT);
+
+    for (uint8_t value(VALUE_MIN); value <= VALUE_MAX; value++){
+        values_[value] = next.values_[values_[value]];
+    }
+}
+
+// apply() : Transform a grid
+//
+//  @source : values of the grid
+//  @dest : will receive the transformed values. Can't be @source
+//
+void gridTransform::apply(const uint8_t* source, uint8_t* dest) const{
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        dest[index] = values_[source[gather_[index]]];
+    }
+}
+
+// apply() : Transform a grid "in place"
+//
+//  @values : values of the grid to transform
+//
+void gridTransform::apply(uint8_t* values) const{
+    uint8_t source[VALUES_COUNT];
+    memcpy(source, values, VALUES_COUNT);
+    apply(source, values);
+}
+
+// apply() : Transform a set of grids
+//
+//  @sources : values of the grids, one after the other
+//  @dests : will receive the transformed grids. Can't be @sources
+//  @count : # of grids
+//
+void gridTransform::apply(const uint8_t* sources, uint8_t* dests,
+                        uint32_t count) const{
+    while (count--){
+        apply(sources, dests);
+        sources += VALUES_COUNT;
+        dests += VALUES_COUNT;
+    }
+}
+
+// mint() : Create variants of a grid, each with a new random
+//          transformation
+//
+//  @source : values of the grid
+//  @dests : will receive the variants, one after the other
+//  @count : # of variants to create
+//  @random : generator of the random numbers
+//
+void gridTransform::mint(const uint8_t* source, uint8_t* dests,
+                        uint32_t count, randomGenerator& random){
+    while (count--){
+        randomize(random);
+        apply(source, dests);
+        dests += VALUES_COUNT;
+    }
+}
+
+//
+// Internal methods
+//
+
+// _isPermutation() : Is a table a permutation ?
+//
+//  @order : table to check
+//  @count : # of items in the table
+//
+//  @return : true if each value in [0, @count[ appears once
+//
+bool gridTransform::_isPermutation(const uint8_t* order, uint8_t count){
+    uint16_t found(0);
+    for (uint8_t index(0); index < count; index++){
+        if (order[index] >= count || (found & (1 << order[index]))){
+            return false;
+        }
+
+        found |= (1 << order[index]);
+    }
+
+    return true;
+}
+
+// _permuteLines() : Change the order of lines
+//
+//  @order : source line of each line
+//
+void gridTransform::_permuteLines(const uint8_t* order){
+    uint8_t gather[VALUES_COUNT];
+    memcpy(gather, gather_, VALUES_COUNT);
+    for (uint8_t line(0); line < LINE_COUNT; line++){
+        memcpy(gather_ + line * ROW_COUNT, gather + order[line] * ROW_COUNT,
+                ROW_COUNT);
+    }
+}
+
+// _permuteRows() : Change the order of rows
+//
+//  @order : source row of each row
+//
+void gridTransform::_permuteRows(const uint8_t* order){
+    uint8_t gather[VALUES_COUNT], row;
+    memcpy(gather, gather_, VALUES_COUNT);
+    for (uint8_t line(0); line < LINE_COUNT; line++){
+        for (row = 0; row < ROW_COUNT; row++){
+            gather_[line * ROW_COUNT + row] =
+                                gather[line * ROW_COUNT + order[row]];
+        }
+    }
+}
+
+// EOF
@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------
+//--
+//--    gridTransform.h
+//--
+//--        Definition of gridTransform object - Transformation of a
+//--        grid that keeps it valid (and keeps its # of solutions)
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_GRID_TRANSFORM_h__
+#define __S_SOLVER_GRID_TRANSFORM_h__    1
+
+#include "element.h"
+#include "randomGenerator.h"
+
+#define TRANSFORM_BLOCK_SIZE    3   // # of lines in a band (rows in a stack)
+#define TRANSFORM_BLOCK_COUNT   (LINE_COUNT / TRANSFORM_BLOCK_SIZE)
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+//   gridTransform : A transformation of a grid
+//
+//      Any composition of value relabelings, permutations of bands
+//      (blocks of 3 lines) and stacks (blocks of 3 rows), permutations
+//      of lines in a band and of rows in a stack and transposition.
+//
+//      The composition is kept as a gather table (source index of each
+//      element) and a relabeling table : applying the transformation
+//      is a single pass on the grid, whatever the number of
+//      elementary transformations composed.
+//
+class gridTransform{
+public:
+
+    // Construction
+    gridTransform(){
+        identity();
+    }
+
+    // Destruction
+    ~gridTransform(){}
+
+    // identity() : Reset to the transformation that changes nothing
+    //
+    void identity();
+
+    // randomize() : Choose a random transformation
+    //
+    //  All the transformations have the same probability
+    //
+    //  @random : generator of the random numbers
+    //
+    void randomize(randomGenerator& random);
+
+    //
+    // Composition
+    //
+    //  Each call is applied after the transformations already composed.
+    //  Orders give, for each destination, the index of its source.
+    //
+
+    // relabel() : Change the values
+    //
+    //  @values : new value of each value (values[0] for VALUE_MIN)
+    //
+    //  @return : false if @values is not a permutation
+    //
+    bool relabel(const uint8_t* values);
+
+    // permuteBands() : Change the order of the bands
+    //
+    //  @order : source band of each band
+    //
+    //  @return : false if @order is not a permutation
+    //
+    bool permuteBands(const uint8_t* order);
+
+    // permuteStacks() : Change the order of the stacks
+    //
+    //  @order : source stack of each stack
+    //
+    //  @return : false if @order is not a permutation
+    //
+    bool permuteStacks(const uint8_t* order);
+
+    // permuteLines() : Change the order of the lines in a band
+    //
+    //  @band : index of the band
+    //  @order : source line (in the band) of each line
+    //
+    //  @return : false if invalid parameters
+    //
+    bool permuteLines(uint8_t band, const uint8_t* order);
+
+    // permuteRows() : Change the order of the rows in a stack
+    //
+    //  @stack : index of the stack
+    //  @order : source row (in the stack) of each row
+    //
+    //  @return : false if invalid parameters
+    //
+    bool permuteRows(uint8_t stack, const uint8_t* order);
+
+    // transpose() : Swap lines and rows
+    //
+    void transpose();
+
+    // compose() : Append another transformation
+    //
+    //  @next : transformation applied after this one
+    //
+    void compose(const gridTransform& next);
+
+    //
+    // Application
+    //
+
+    // apply() : Transform a grid
+    //
+    //  @source : values of the grid
+    //  @dest : will receive the transformed values. Can't be @source
+    //
+    void apply(const uint8_t* source, uint8_t* dest) const;
+
+    // apply() : Transform a grid "in place"
+    //
+    //  @values : values of the grid to transform
+    //
+    void apply(uint8_t* values) const;
+
+    // apply() : Transform a set of grids
+    //
+    //  @sources : values of the grids, one after the other
+    //  @dests : will receive the transformed grids. Can't be @sources
+    //  @count : # of grids
+    //
+    void apply(const uint8_t* sources, uint8_t* dests, uint32_t count) const;
+
+    // mint() : Create variants of a grid, each with a new random
+    //          transformation
+    //
+    //  @source : values of the grid
+    //  @dests : will receive the variants, one after the other
+    //  @count : # of variants to create
+    //  @random : generator of the random numbers
+    //
+    void mint(const uint8_t* source, uint8_t* dests, uint32_t count,
+                randomGenerator& random);
+
+private:
+
+    // _isPermutation() : Is a table a permutation ?
+    //
+    //  @order : table to check
+    //  @count : # of items in the table
+    //
+    //  @return : true if each value in [0, @count[ appears once
+    //
+    static bool _isPermutation(const uint8_t* order, uint8_t count);
+
+    // _permuteLines() : Change the order of lines
+    //
+    //  @order : source line of each line
+    //
+    void _permuteLines(const uint8_t* order);
+
+    // _permuteRows() : Change the order of rows
+    //
+    //  @order : source row of each row
+    //
+    void _permuteRows(const uint8_t* order);
+
+    // Members
+private:
+    uint8_t gather_[VALUES_COUNT];      // Source index of each element
+    uint8_t values_[VALUE_MAX + 1];     // New value of each value
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_GRID_TRANSFORM_h__
+
+// EOF
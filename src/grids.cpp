@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------
 
 #include "grids.h"
+#include "sudoku.h"
 #include <cstdlib>
 
 #ifndef DEST_CASIO_CALC
@@ -21,6 +22,8 @@ using namespace std;
 
 #define MAX_FILE_ID             0xFFFF
 
+#define MIN_BUCKET_COUNT        16      // Min. size of the content index
+
 // Construction
 //
 grids::grids(){
@@ -29,6 +32,10 @@ grids::grids(){
     count_ = 0;
     capacity_ = 0;
 
+    buckets_ = NULL;    // No content index
+    bucketCount_ = 0;
+    duplicates_ = 0;
+
     // this folder
     strcpy(folder_, GRIDS_FOLDER);
     strcat(folder_, PATH_SEPARATOR);
@@ -38,6 +45,10 @@ grids::grids(){
 //
 grids::~grids(){
     __vector_clear(true);
+
+    if (buckets_){
+        free(buckets_);
+    }
 }
 
 // currentFileName() : Get surrent filename
@@ -144,6 +155,20 @@ int grids::browse(){
         folder.findClose(shandle);
     }
 
+    // Keys of the files
+    if (_readIndex()){
+        // Read the new files
+        for (int index(0); index < count_; index++){
+            if (files_[index] && !files_[index]->keyed){
+                _keyFile(files_[index]);
+            }
+        }
+
+        _writeIndex();
+    }
+
+    duplicates_ = _buildIndex();
+
     index_ = -1;
     return count_;
 }
@@ -250,18 +275,15 @@ bool grids::deleteFile(){
         // remove from disk
         bFile current;
         if (current.remove(fName)){
+            PFNAME file(files_[index_]);
+            int bucket((buckets_ && file->keyed)?_bucket(file->key):-1);
+            _unlink(file);
+
             // remove from list
-            int ID(__fileName2i(fName));
-            PFNAME pFile(NULL);
-            bool done(false);
-            for (int index=0; !done && index < count_; index++){
-                if ((pFile = files_[index]) && ID == pFile->ID){
-                    _freeFileName(pFile);
-                    files_[index] = NULL;
-                    done = true;
-                }
-            }
+            _freeFileName(file);
+            files_[index_] = NULL;
 
+            _reindex(bucket);
             return true;
         }
     }
@@ -269,6 +291,71 @@ bool grids::deleteFile(){
     return false;
 }
 
+// findGrid() : Find a file with the same grid
+//
+//  @values : values of the grid
+//  @index : index of a file to ignore (-1 if none)
+//
+//  @return : ID of the file or -1 if not found
+//
+int grids::findGrid(const uint8_t* values, int index){
+    GRID_HASH key;
+    if (!buckets_ || !canonicalizer_.key(values, key)){
+        return -1;
+    }
+
+    PFNAME ignore((index >= 0 && index < count_)?files_[index]:NULL);
+    for (PFNAME file = buckets_[_bucket(key)]; file; file = file->nextKey){
+        if (file != ignore && gridCanonicalizer::sameHash(file->key, key)){
+            return file->ID;
+        }
+    }
+
+    // Not found
+    return -1;
+}
+
+// setGrid() : Update the key of a file whose grid has changed
+//
+//  @index : index of the file in the list
+//  @values : new values of the grid
+//
+//  @return : true if updated
+//
+bool grids::setGrid(int index, const uint8_t* values){
+    PFNAME file((index >= 0 && index < count_)?files_[index]:NULL);
+    if (!file){
+        return false;
+    }
+
+    int bucket((buckets_ && file->keyed)?_bucket(file->key):-1);
+    _unlink(file);
+    if (!(file->keyed = canonicalizer_.key(values, file->key))){
+        file->original = -1;
+        _reindex(bucket);
+        return false;
+    }
+
+    if (count_ > bucketCount_){
+        duplicates_ = _buildIndex();    // Too many files per bucket
+        return _writeIndex();
+    }
+
+    _link(file);
+    return _reindex(bucket);
+}
+
+// duplicateOf() : Is a file a duplicate ?
+//
+//  @index : index of the file in the list
+//
+//  @return : ID of the first file with the same grid or -1
+//
+int grids::duplicateOf(int index){
+    return ((index >= 0 && index < count_ && files_[index])?
+                files_[index]->original:-1);
+}
+
 #ifndef DEST_CASIO_CALC
 // content() : display list content
 //
@@ -335,6 +422,263 @@ bool grids::_addFile(const FONTCHARACTER fileName){
     return __vector_add(file);
 }
 
+//
+// Content index
+//
+
+// _keyFile() : Compute the key of a file
+//
+//  @file : file to read
+//
+//  @return : true if the key is valid
+//
+bool grids::_keyFile(PFNAME file){
+    uint8_t values[VALUES_COUNT];
+    file->keyed = (FILE_NO_ERROR == sudoku::readValues(file->fileName, values)
+                    && canonicalizer_.key(values, file->key));
+    return file->keyed;
+}
+
+// _readIndex() : Get the keys of the files from the index file
+//
+//  Files and entries of the index file are both ordered by ID
+//
+//  @return : # of changes (files with no key and entries of
+//          removed files)
+//
+int grids::_readIndex(){
+    int changes(0), count(0), entry(0), index;
+    INDEX_ENTRY* entries(NULL);
+
+#ifdef DEST_CASIO_CALC
+    uint16_t fName[BFILE_MAX_PATH + 1];
+#else
+    char fName[BFILE_MAX_PATH + 1];
+#endif // DEST_CASIO_CALC
+    _indexFileName(fName);
+
+    bFile iFile;
+    if (iFile.open(fName, BFile_ReadOnly)){
+        count = iFile.size() / sizeof(INDEX_ENTRY);
+        if (count && NULL != (entries = (INDEX_ENTRY*)malloc(
+                                        count * sizeof(INDEX_ENTRY)))){
+            count = iFile.read(entries, count * sizeof(INDEX_ENTRY), 0)
+                    / sizeof(INDEX_ENTRY);
+        }
+        else{
+            count = 0;
+        }
+
+        iFile.close();
+    }
+
+    PFNAME file;
+    for (index = 0; index < count_; index++){
+        if (NULL == (file = files_[index])){
+            continue;
+        }
+
+        while (entry < count && entries[entry].ID < file->ID){
+            entry++;    // This file has been removed
+            changes++;
+        }
+
+        if (entry < count && entries[entry].ID == file->ID){
+            memcpy(&file->key, &entries[entry++].key, sizeof(GRID_HASH));
+            file->keyed = true;
+        }
+        else{
+            file->keyed = false;
+            changes++;
+        }
+    }
+
+    changes += (count - entry);
+    if (entries){
+        free(entries);
+    }
+
+    return changes;
+}
+
+// _writeIndex() : Save the keys of the files in the index file
+//
+//  @return : true if saved
+//
+bool grids::_writeIndex(){
+#ifdef DEST_CASIO_CALC
+    uint16_t fName[BFILE_MAX_PATH + 1];
+#else
+    char fName[BFILE_MAX_PATH + 1];
+#endif // DEST_CASIO_CALC
+    _indexFileName(fName);
+
+    bFile oFile;
+    oFile.remove(fName);    // Remove the file (if already exist)
+
+    INDEX_ENTRY* entries(count_?
+        (INDEX_ENTRY*)malloc(count_ * sizeof(INDEX_ENTRY)):NULL);
+    if (!entries){
+        return (0 == count_);
+    }
+
+    // Keyed files, in ID order
+    int count(0);
+    PFNAME file;
+    for (int index(0); index < count_; index++){
+        if ((file = files_[index]) && file->keyed){
+            entries[count].ID = (uint16_t)file->ID;
+            entries[count].reserved = 0;
+            memcpy(&entries[count++].key, &file->key, sizeof(GRID_HASH));
+        }
+    }
+
+    bool done(false);
+    int fSize(count * sizeof(INDEX_ENTRY));
+    if (fSize &&
+        oFile.createEx(fName, BFile_File, &fSize, BFile_WriteOnly)){
+        done = oFile.write(entries, fSize);
+        oFile.close();
+    }
+
+    free(entries);
+    return done;
+}
+
+// _buildIndex() : Put all the keyed files in the buckets
+//
+//  @return : # of duplicates
+//
+int grids::_buildIndex(){
+    // At least one bucket per file
+    int size(MIN_BUCKET_COUNT);
+    while (size < count_){
+        size *= 2;
+    }
+
+    if (size != bucketCount_){
+        if (buckets_){
+            free(buckets_);
+        }
+
+        if (NULL == (buckets_ = (PFNAME*)malloc(size * sizeof(PFNAME)))){
+            bucketCount_ = 0;
+            return 0;
+        }
+
+        bucketCount_ = size;
+    }
+
+    memset(buckets_, 0x00, bucketCount_ * sizeof(PFNAME));
+
+    int duplicates(0);
+    PFNAME file;
+    for (int index(0); index < count_; index++){
+        if ((file = files_[index]) && -1 != _link(file)){
+            duplicates++;
+        }
+    }
+
+    return duplicates;
+}
+
+// _link() : Add a file in its bucket
+//
+//  @file : file to add
+//
+//  @return : ID of the first file with the same key or -1
+//
+int grids::_link(PFNAME file){
+    file->original = -1;
+    file->nextKey = NULL;
+    if (!buckets_ || !file->keyed){
+        return -1;
+    }
+
+    // Append at the end of the bucket
+    int original(-1);
+    PFNAME* pos(&buckets_[_bucket(file->key)]);
+    while (*pos){
+        if (-1 == original
+            && gridCanonicalizer::sameHash((*pos)->key, file->key)){
+            original = (*pos)->ID;
+        }
+
+        pos = &(*pos)->nextKey;
+    }
+
+    (*pos) = file;
+    return (file->original = original);
+}
+
+// _unlink() : Remove a file from its bucket
+//
+//  @file : file to remove
+//
+void grids::_unlink(PFNAME file){
+    if (!buckets_ || !file || !file->keyed){
+        return;
+    }
+
+    PFNAME* pos(&buckets_[_bucket(file->key)]);
+    while (*pos && *pos != file){
+        pos = &(*pos)->nextKey;
+    }
+
+    if (*pos){
+        (*pos) = file->nextKey;
+    }
+
+    file->nextKey = NULL;
+}
+
+// _reindex() : Update the content index after a file has been
+//              removed from a bucket
+//
+//  The files of the bucket are linked again to the first file
+//  with the same key, duplicates are counted and the index file
+//  is saved
+//
+//  @bucket : index of the bucket (-1 if none)
+//
+//  @return : true if the index file is saved
+//
+bool grids::_reindex(int bucket){
+    PFNAME file, other;
+    if (bucket >= 0 && bucket < bucketCount_){
+        for (file = buckets_[bucket]; file; file = file->nextKey){
+            file->original = -1;
+            for (other = buckets_[bucket];
+                other != file && -1 == file->original;
+                other = other->nextKey){
+                if (gridCanonicalizer::sameHash(other->key, file->key)){
+                    file->original = other->ID;
+                }
+            }
+        }
+    }
+
+    duplicates_ = 0;
+    for (int index(0); index < count_; index++){
+        if ((file = files_[index]) && -1 != file->original){
+            duplicates_++;
+        }
+    }
+
+    return _writeIndex();
+}
+
+// _indexFileName() : Full name of the index file
+//
+//  @fName : will receive the name
+//
+void grids::_indexFileName(FONTCHARACTER fName){
+    char name[BFILE_MAX_PATH + 1];
+    strcpy(name, folder_);
+    strcat(name, INDEX_FILE_NAME);
+    bFile::FC_str2FC(name, fName);
+}
+
 // _freeFileName : free the menory used by the FNAME struct.
 //
 //  @pItem : pointer to item to be freed
@@ -478,6 +822,12 @@ void grids::__vector_clear(bool freeList){
 
         count_ = 0; // List is empty
 
+        // and so is the content index
+        if (buckets_){
+            memset(buckets_, 0x00, bucketCount_ * sizeof(PFNAME));
+        }
+        duplicates_ = 0;
+
         if (freeList){
             free(files_);
             capacity_ = 0;
@@ -13,8 +13,13 @@
 #define __S_SOLVER_GRID_h__    1
 
 #include "consts.h"
+#include "gridCanonicalizer.h"
 #include "shared/bFile.h"
 
+// Content index (in the grids folder)
+//
+#define INDEX_FILE_NAME     "index.bin"
+
 #ifdef __cplusplus
 extern "C" {
 #endif // #ifdef __cplusplus
@@ -107,10 +112,59 @@ public:
 
     // deleteFile() : Delete current file
     //
+    //  The content index is updated : duplicates of the file are
+    //  linked to the next file with the same grid
+    //
     //  @return : true if deleted
     //
     bool deleteFile();
 
+    //
+    // Content index
+    //
+    //  Files are indexed by the key of their canonical form : two files
+    //  with the same grid, even transformed, have the same key.
+    //  Keys are kept in INDEX_FILE_NAME and only the new files are
+    //  read by browse().
+    //
+
+    // findGrid() : Find a file with the same grid
+    //
+    //  @values : values of the grid
+    //  @index : index of a file to ignore (-1 if none)
+    //
+    //  @return : ID of the file or -1 if not found
+    //
+    int findGrid(const uint8_t* values, int index = -1);
+
+    // setGrid() : Update the key of a file whose grid has changed
+    //
+    //  Files that were duplicates of the previous grid are linked
+    //  again and the index file is saved
+    //
+    //  @index : index of the file in the list
+    //  @values : new values of the grid
+    //
+    //  @return : true if updated
+    //
+    bool setGrid(int index, const uint8_t* values);
+
+    // duplicates() : # of files whose grid is already in another file
+    //
+    //  @return : # of duplicates found by the last browse()
+    //
+    int duplicates(){
+        return duplicates_;
+    }
+
+    // duplicateOf() : Is a file a duplicate ?
+    //
+    //  @index : index of the file in the list
+    //
+    //  @return : ID of the first file with the same grid or -1
+    //
+    int duplicateOf(int index);
+
 #ifndef DEST_CASIO_CALC
     // content() : display list content
     //
@@ -133,8 +187,90 @@ private:
     typedef struct _FNAME{
         FONTCHARACTER   fileName;   // FQN
         int ID;
+        bool keyed;         // Is key valid ?
+        GRID_HASH key;      // Key of the grid
+        int original;       // ID of the first file with the same key (or -1)
+        struct _FNAME* nextKey;     // Next file in the same bucket
     }FNAME,* PFNAME;
 
+    // An entry of the index file
+    //
+    typedef struct _INDEX_ENTRY{
+        uint16_t ID;
+        uint16_t reserved;  // Keeps words aligned
+        GRID_HASH key;
+    }INDEX_ENTRY;
+
+    //
+    // Content index
+    //
+
+    // _keyFile() : Compute the key of a file
+    //
+    //  @file : file to read
+    //
+    //  @return : true if the key is valid
+    //
+    bool _keyFile(PFNAME file);
+
+    // _readIndex() : Get the keys of the files from the index file
+    //
+    //  @return : # of changes (files with no key and entries of
+    //          removed files)
+    //
+    int _readIndex();
+
+    // _writeIndex() : Save the keys of the files in the index file
+    //
+    //  @return : true if saved
+    //
+    bool _writeIndex();
+
+    // _buildIndex() : Put all the keyed files in the buckets
+    //
+    //  @return : # of duplicates
+    //
+    int _buildIndex();
+
+    // _link() : Add a file in its bucket
+    //
+    //  @file : file to add
+    //
+    //  @return : ID of the first file with the same key or -1
+    //
+    int _link(PFNAME file);
+
+    // _unlink() : Remove a file from its bucket
+    //
+    //  @file : file to remove
+    //
+    void _unlink(PFNAME file);
+
+    // _reindex() : Update the content index after a file has been
+    //              removed from a bucket
+    //
+    //  @bucket : index of the bucket (-1 if none)
+    //
+    //  @return : true if the index file is saved
+    //
+    bool _reindex(int bucket);
+
+    // _bucket() : Bucket of a key
+    //
+    //  @key : key
+    //
+    //  @return : index of the bucket
+    //
+    int _bucket(const GRID_HASH& key){
+        return (int)(key.words[0] & (bucketCount_ - 1));
+    }
+
+    // _indexFileName() : Full name of the index file
+    //
+    //  @fName : will receive the name
+    //
+    void _indexFileName(FONTCHARACTER fName);
+
     //
     //  "vector" management
     //
@@ -224,6 +360,12 @@ private:
     PFNAME* files_;     // List of files
     int     capacity_;  // max. size of buffer
     int     count_;     // Item count
+
+    // Content index
+    PFNAME* buckets_;   // Files by key
+    int     bucketCount_;   // # of buckets (a power of 2)
+    int     duplicates_;
+    gridCanonicalizer canonicalizer_;
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,743 @@
+//----------------------------------------------------------------------
+//--
+//--    humanSolver.cpp
+//--
+//--        Implementation of humanSolver object - Solve a board with
+//--        the techniques used by human players
+//--
+//----------------------------------------------------------------------
+
+#include "humanSolver.h"
+
+// Techniques in cost order (same order as TECHNIQUE_ID)
+//
+const humanSolver::TECHNIQUE humanSolver::techniques_[TECH_COUNT] = {
+    {"Naked single",    10, &humanSolver::_nakedSingles,    1},
+    {"Hidden single",   15, &humanSolver::_hiddenSingles,   1},
+    {"Pointing",        26, &humanSolver::_pointing,        0},
+    {"Box/line",        28, &humanSolver::_boxLine,         0},
+    {"Naked pair",      30, &humanSolver::_nakedSubsets,    2},
+    {"X-Wing",          32, &humanSolver::_fish,            2},
+    {"Hidden pair",     34, &humanSolver::_hiddenSubsets,   2},
+    {"Naked triple",    36, &humanSolver::_nakedSubsets,    3},
+    {"Swordfish",       38, &humanSolver::_fish,            3},
+    {"Hidden triple",   40, &humanSolver::_hiddenSubsets,   3},
+    {"XY-Wing",         42, &humanSolver::_xyWing,          0},
+    {"Colouring",       45, &humanSolver::_colouring,       0},
+    {"Naked quad",      50, &humanSolver::_nakedSubsets,    4},
+    {"Hidden quad",     54, &humanSolver::_hiddenSubsets,   4}
+};
+
+// Construction
+//
+humanSolver::humanSolver(){
+    memset(values_, EMPTY_VALUE, sizeof(values_));
+    memset(cands_, 0, sizeof(cands_));
+    memset(uses_, 0, sizeof(uses_));
+    empties_ = 0;
+    valid_ = false;
+    hardest_ = TECH_NONE;
+}
+
+// solve() : Apply the techniques until none can progress
+//
+//  @values : values of the board. Will receive the values found
+//  @maxTech : ID of the most expensive technique allowed
+//
+//  @return : # of values found or -1 if the board can't be solved
+//
+int8_t humanSolver::solve(uint8_t* values, uint8_t maxTech){
+    if (!values || !_load(values)){
+        return -1;
+    }
+
+    uint8_t tech(0);
+    while (valid_ && empties_ && tech <= maxTech && tech < TECH_COUNT){
+        if ((this->*techniques_[tech].apply)(techniques_[tech].size)){
+            uses_[tech]++;
+            if ((int8_t)tech > hardest_){
+                hardest_ = tech;
+            }
+
+            tech = 0;   // Back to the cheapest technique
+        }
+        else{
+            tech++;
+        }
+    }
+
+    if (!valid_){
+        return -1;
+    }
+
+    // Copy the values found
+    int8_t count(0);
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        if (EMPTY_VALUE == values[index] && values_[index]){
+            values[index] = values_[index];
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// grade() : Rating of a board
+//
+//  The board is solved with the techniques only : its rating is
+//  the rating of the most expensive technique needed
+//
+//  @values : values of the board (left unchanged)
+//
+//  @return : rating (x 10), GRADE_NONE, GRADE_SEARCH if the board
+//          can't be completed or GRADE_INVALID
+//
+int8_t humanSolver::grade(const uint8_t* values){
+    if (!values){
+        return GRADE_INVALID;
+    }
+
+    uint8_t board[VALUES_COUNT];
+    memcpy(board, values, VALUES_COUNT);
+    if (solve(board) < 0){
+        return GRADE_INVALID;
+    }
+
+    if (!solved()){
+        return GRADE_SEARCH;
+    }
+
+    return ((TECH_NONE == hardest_)?GRADE_NONE:techniques_[hardest_].cost);
+}
+
+// techniqueName() : Name of a technique
+//
+//  @tech : ID of the technique
+//
+//  @return : the name or NULL if invalid ID
+//
+const char* humanSolver::techniqueName(uint8_t tech){
+    return ((tech < TECH_COUNT)?techniques_[tech].name:NULL);
+}
+
+// techniqueCost() : Rating of a technique
+//
+//  @tech : ID of the technique
+//
+//  @return : rating (x 10) or 0 if invalid ID
+//
+uint8_t humanSolver::techniqueCost(uint8_t tech){
+    return ((tech < TECH_COUNT)?techniques_[tech].cost:0);
+}
+
+//
+// Internal methods
+//
+
+// _load() : Copy a board and compute the candidates
+//
+//  @values : values of the board
+//
+//  @return : false if a value is in conflict with another one
+//
+bool humanSolver::_load(const uint8_t* values){
+    memset(uses_, 0, sizeof(uses_));
+    hardest_ = TECH_NONE;
+    valid_ = false;
+
+    // Values used in each unit
+    uint16_t masks[UNIT_COUNT];
+    memset(masks, 0, sizeof(masks));
+
+    uint8_t index, value;
+    uint16_t bit;
+    empties_ = 0;
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        if ((value = values_[index] = values[index]) > VALUE_MAX){
+            return false;
+        }
+
+        if (EMPTY_VALUE == value){
+            empties_++;
+            continue;
+        }
+
+        bit = VALUE_BIT(value);
+        if ((masks[UNIT_LINE + gGridTables.line[index]]
+            | masks[UNIT_ROW + gGridTables.row[index]]
+            | masks[UNIT_SQUARE + gGridTables.square[index]]) & bit){
+            return false;   // Already in a unit
+        }
+
+        masks[UNIT_LINE + gGridTables.line[index]] |= bit;
+        masks[UNIT_ROW + gGridTables.row[index]] |= bit;
+        masks[UNIT_SQUARE + gGridTables.square[index]] |= bit;
+    }
+
+    valid_ = true;
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        if (EMPTY_VALUE == values_[index]){
+            if (!(cands_[index] = ALL_VALUES_MASK &
+                        ~(masks[UNIT_LINE + gGridTables.line[index]]
+                        | masks[UNIT_ROW + gGridTables.row[index]]
+                        | masks[UNIT_SQUARE + gGridTables.square[index]]))){
+                valid_ = false;
+            }
+        }
+        else{
+            cands_[index] = 0;
+        }
+    }
+
+    return true;
+}
+
+// _place() : Set a value and remove it from the peers' candidates
+//
+//  @index : index of the position
+//  @value : value to set
+//
+void humanSolver::_place(uint8_t index, uint8_t value){
+    values_[index] = value;
+    cands_[index] = 0;
+    empties_--;
+
+    uint16_t bit(VALUE_BIT(value));
+    uint8_t peer;
+    for (uint8_t id(0); id < PEER_COUNT; id++){
+        peer = gGridTables.peers[index][id];
+        if (EMPTY_VALUE == values_[peer]){
+            _eliminate(peer, bit);
+        }
+    }
+}
+
+// _nakedSingles() : Positions with a single candidate
+//
+//  @return : # of values set
+//
+uint16_t humanSolver::_nakedSingles(uint8_t){
+    uint16_t count(0), candidates;
+    for (uint8_t index(INDEX_MIN); valid_ && index <= INDEX_MAX; index++){
+        if (EMPTY_VALUE == values_[index]){
+            candidates = cands_[index];
+            if (candidates && !(candidates & (candidates - 1))){
+                _place(index, VALUE_MIN + __builtin_ctz(candidates));
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+// _hiddenSingles() : Values with a single position in a unit
+//
+//  @return : # of values set
+//
+uint16_t humanSolver::_hiddenSingles(uint8_t){
+    uint16_t count(0), once, twice, used, candidates;
+    uint8_t unit, id, index;
+    for (unit = 0; valid_ && unit < UNIT_COUNT; unit++){
+        // Values that are candidates at least once and twice in the unit
+        once = twice = used = 0;
+        for (id = 0; id < VALUE_MAX; id++){
+            index = gGridTables.units[unit][id];
+            if (EMPTY_VALUE == values_[index]){
+                twice |= (once & cands_[index]);
+                once |= cands_[index];
+            }
+            else{
+                used |= VALUE_BIT(values_[index]);
+            }
+        }
+
+        if ((once | used) != ALL_VALUES_MASK){
+            valid_ = false;     // A missing value can't be put in the unit
+            return 1;
+        }
+
+        if ((once &= ~twice)){
+            for (id = 0; valid_ && id < VALUE_MAX; id++){
+                index = gGridTables.units[unit][id];
+                if ((candidates = (cands_[index] & once))){
+                    if (candidates & (candidates - 1)){
+                        valid_ = false; // 2 values for a single position
+                        return 1;
+                    }
+
+                    _place(index, VALUE_MIN + __builtin_ctz(candidates));
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// _pointing() : Candidates of a tinySquare all in the same line
+//              or row are removed from the rest of this line or row
+//
+//  @return : # of changes
+//
+uint16_t humanSolver::_pointing(uint8_t){
+    uint16_t count(0), bit, lines, rows;
+    uint8_t square, value, id, index, unit;
+    for (square = 0; square < TINY_COUNT; square++){
+        for (value = VALUE_MIN; value <= VALUE_MAX; value++){
+            // Lines and rows of the candidates in the tinySquare
+            bit = VALUE_BIT(value);
+            lines = rows = 0;
+            for (id = 0; id < VALUE_MAX; id++){
+                index = gGridTables.units[UNIT_SQUARE + square][id];
+                if (cands_[index] & bit){
+                    lines |= (1 << gGridTables.line[index]);
+                    rows |= (1 << gGridTables.row[index]);
+                }
+            }
+
+            unit = UNIT_COUNT;
+            if (lines && !(lines & (lines - 1))){
+                unit = UNIT_LINE + __builtin_ctz(lines);
+            }
+            else if (rows && !(rows & (rows - 1))){
+                unit = UNIT_ROW + __builtin_ctz(rows);
+            }
+
+            if (unit < UNIT_COUNT){
+                for (id = 0; id < VALUE_MAX; id++){
+                    index = gGridTables.units[unit][id];
+                    if (gGridTables.square[index] != square){
+                        count += _eliminate(index, bit);
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// _boxLine() : Candidates of a line or row all in the same
+//              tinySquare are removed from the rest of the tinySquare
+//
+//  @return : # of changes
+//
+uint16_t humanSolver::_boxLine(uint8_t){
+    uint16_t count(0), bit, squares;
+    uint8_t unit, value, id, index, square;
+    for (unit = UNIT_LINE; unit < UNIT_SQUARE; unit++){
+        for (value = VALUE_MIN; value <= VALUE_MAX; value++){
+            // tinySquares of the candidates in the line (or row)
+            bit = VALUE_BIT(value);
+            squares = 0;
+            for (id = 0; id < VALUE_MAX; id++){
+                index = gGridTables.units[unit][id];
+                if (cands_[index] & bit){
+                    squares |= (1 << gGridTables.square[index]);
+                }
+            }
+
+            if (squares && !(squares & (squares - 1))){
+                square = UNIT_SQUARE + __builtin_ctz(squares);
+                for (id = 0; id < VALUE_MAX; id++){
+                    index = gGridTables.units[square][id];
+                    if (!_inUnit(index, unit)){
+                        count += _eliminate(index, bit);
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// _nakedSubsets() : @size positions of a unit with only @size
+//              candidates : they are removed from the rest of the unit
+//
+//  @size : size of the subset
+//
+//  @return : # of changes
+//
+uint16_t humanSolver::_nakedSubsets(uint8_t size){
+    uint16_t count(0), combo, candidates;
+    uint8_t unit, id, empty, cells[VALUE_MAX];
+    for (unit = 0; valid_ && unit < UNIT_COUNT; unit++){
+        // Empty positions of the unit
+        empty = 0;
+        for (id = 0; id < VALUE_MAX; id++){
+            if (EMPTY_VALUE == values_[gGridTables.units[unit][id]]){
+                cells[empty++] = gGridTables.units[unit][id];
+            }
+        }
+
+        if (empty <= size){
+            continue;
+        }
+
+        // All the subsets of @size positions
+        for (combo = 1; combo < (1 << empty); combo++){
+            if (__builtin_popcount(combo) != size){
+                continue;
+            }
+
+            candidates = 0;
+            for (id = 0; id < empty; id++){
+                if (combo & (1 << id)){
+                    candidates |= cands_[cells[id]];
+                }
+            }
+
+            if (__builtin_popcount(candidates) < size){
+                valid_ = false; // Not enough values for the positions
+                return 1;
+            }
+
+            if (__builtin_popcount(candidates) == size){
+                for (id = 0; id < empty; id++){
+                    if (!(combo & (1 << id))){
+                        count += _eliminate(cells[id], candidates);
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// _hiddenSubsets() : @size values of a unit that can only be
+//              at @size positions : the other candidates
+//              of these positions are removed
+//
+//  @size : size of the subset
+//
+//  @return : # of changes
+//
+uint16_t humanSolver::_hiddenSubsets(uint8_t size){
+    uint16_t count(0), combo, positions, subset;
+    uint16_t valuePos[VALUE_MAX];   // Positions (as bits) of each value
+    uint8_t unit, id, value, missing, values[VALUE_MAX];
+    for (unit = 0; valid_ && unit < UNIT_COUNT; unit++){
+        memset(valuePos, 0, sizeof(valuePos));
+        for (id = 0; id < VALUE_MAX; id++){
+            for (value = 0; value < VALUE_MAX; value++){
+                if (cands_[gGridTables.units[unit][id]] & (1 << value)){
+                    valuePos[value] |= (1 << id);
+                }
+            }
+        }
+
+        // Values not set in the unit
+        missing = 0;
+        for (value = 0; value < VALUE_MAX; value++){
+            if (valuePos[value]){
+                values[missing++] = value;
+            }
+        }
+
+        if (missing <= size){
+            continue;
+        }
+
+        // All the subsets of @size values
+        for (combo = 1; combo < (1 << missing); combo++){
+            if (__builtin_popcount(combo) != size){
+                continue;
+            }
+
+            positions = subset = 0;
+            for (id = 0; id < missing; id++){
+                if (combo & (1 << id)){
+                    positions |= valuePos[values[id]];
+                    subset |= (1 << values[id]);
+                }
+            }
+
+            if (__builtin_popcount(positions) < size){
+                valid_ = false; // Not enough positions for the values
+                return 1;
+            }
+
+            if (__builtin_popcount(positions) == size){
+                for (id = 0; id < VALUE_MAX; id++){
+                    if (positions & (1 << id)){
+                        count += _eliminate(gGridTables.units[unit][id],
+                                            ALL_VALUES_MASK & ~subset);
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// _fish() : X-Wing (@size = 2) and Swordfish (@size = 3)
+//
+//  If the candidates of a value in @size lines are all in the same
+//  @size rows, the value is removed from the other lines of these
+//  rows (and the same with rows and lines swapped)
+//
+//  @size : # of lines (or rows)
+//
+//  @return : # of changes
+//
+uint16_t humanSolver::_fish(uint8_t size){
+    uint16_t count(0), bit, combo, covers, cover[LINE_COUNT];
+    uint8_t value, base, id, bases, index, baseIDs[LINE_COUNT];
+    bool byLine;
+    for (value = VALUE_MIN; valid_ && value <= VALUE_MAX; value++){
+        bit = VALUE_BIT(value);
+        for (uint8_t dir(0); dir < 2; dir++){
+            byLine = (0 == dir);
+
+            // Bases with 2 to @size candidates
+            bases = 0;
+            for (base = 0; base < LINE_COUNT; base++){
+                cover[base] = 0;
+                for (id = 0; id < ROW_COUNT; id++){
+                    index = (byLine?(base * ROW_COUNT + id):
+                                    (id * ROW_COUNT + base));
+                    if (cands_[index] & bit){
+                        cover[base] |= (1 << id);
+                    }
+                }
+
+                if (__builtin_popcount(cover[base]) >= 2
+                    && __builtin_popcount(cover[base]) <= size){
+                    baseIDs[bases++] = base;
+                }
+            }
+
+            if (bases < size){
+                continue;   // Not enough bases for a fish
+            }
+
+            for (combo = 1; combo < (1 << bases); combo++){
+                if (__builtin_popcount(combo) != size){
+                    continue;
+                }
+
+                covers = 0;
+                for (id = 0; id < bases; id++){
+                    if (combo & (1 << id)){
+                        covers |= cover[baseIDs[id]];
+                    }
+                }
+
+                if (__builtin_popcount(covers) != size){
+                    continue;
+                }
+
+                // Remove the value from the other bases
+                for (base = 0; base < LINE_COUNT; base++){
+                    for (id = 0; id < bases; id++){
+                        if ((combo & (1 << id)) && baseIDs[id] == base){
+                            break;
+                        }
+                    }
+
+                    if (id < bases){
+                        continue;   // Part of the fish
+                    }
+
+                    for (id = 0; id < ROW_COUNT; id++){
+                        if (covers & (1 << id)){
+                            index = (byLine?(base * ROW_COUNT + id):
+                                            (id * ROW_COUNT + base));
+                            count += _eliminate(index, bit);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// _xyWing() : Pivot {x,y} with pincers {x,z} and {y,z} : z is
+//              removed from the common peers of the pincers
+//
+//  @return : # of changes
+//
+uint16_t humanSolver::_xyWing(uint8_t){
+    uint16_t count(0), pivotCands, first, second, z;
+    uint8_t pivot, id, other, pincer, pincer2, peer;
+    for (pivot = INDEX_MIN; valid_ && pivot <= INDEX_MAX; pivot++){
+        pivotCands = cands_[pivot];
+        if (__builtin_popcount(pivotCands) != 2){
+            continue;
+        }
+
+        for (id = 0; id < PEER_COUNT; id++){
+            pincer = gGridTables.peers[pivot][id];
+            first = cands_[pincer];
+            if (__builtin_popcount(first) != 2
+                || __builtin_popcount(first & pivotCands) != 1){
+                continue;
+            }
+
+            // The other pincer has the other value of the pivot and z
+            z = first & ~pivotCands;
+            second = (pivotCands & ~first) | z;
+            for (other = 0; other < PEER_COUNT; other++){
+                pincer2 = gGridTables.peers[pivot][other];
+                if (cands_[pincer2] != second){
+                    continue;
+                }
+
+                for (uint8_t peerID(0); peerID < PEER_COUNT; peerID++){
+                    peer = gGridTables.peers[pincer][peerID];
+                    if (peer != pincer2 && _isPeer(peer, pincer2)){
+                        count += _eliminate(peer, z);
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// _colouring() : Simple colouring of the conjugate pairs of a value
+//
+//  @return : # of changes
+//
+uint16_t humanSolver::_colouring(uint8_t){
+    uint16_t count(0);
+    for (uint8_t value(VALUE_MIN); valid_ && value <= VALUE_MAX; value++){
+        count += _colourValue(value);
+    }
+
+    return count;
+}
+
+// _colourValue() : Simple colouring for a single value
+//
+//  Positions linked by a conjugate pair (the only 2 positions of the
+//  value in a unit) get opposite colours; in a chain, one of the
+//  colours is the value :
+//      - if 2 positions of the same colour share a unit, this colour
+//        is wrong;
+//      - a position that sees both colours of a chain can't have
+//        the value.
+//
+//  @value : value
+//
+//  @return : # of candidates removed
+//
+uint16_t humanSolver::_colourValue(uint8_t value){
+    uint16_t count(0), bit(VALUE_BIT(value));
+    uint8_t unitCount[UNIT_COUNT], colour[VALUES_COUNT];
+    uint8_t stack[VALUES_COUNT];
+    uint8_t unit, id, index, other, depth, chain(0);
+    uint8_t units[3];
+
+    // # of positions of the value in each unit
+    for (unit = 0; unit < UNIT_COUNT; unit++){
+        unitCount[unit] = 0;
+        for (id = 0; id < VALUE_MAX; id++){
+            if (cands_[gGridTables.units[unit][id]] & bit){
+                unitCount[unit]++;
+            }
+        }
+    }
+
+    // Colour the chains : colours of chain n are 2n and 2n + 1
+    memset(colour, 0, sizeof(colour));
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        if (!(cands_[index] & bit) || colour[index]){
+            continue;
+        }
+
+        colour[index] = 2 * (++chain);
+        stack[0] = index;
+        depth = 1;
+        while (depth){
+            other = stack[--depth];
+            units[0] = UNIT_LINE + gGridTables.line[other];
+            units[1] = UNIT_ROW + gGridTables.row[other];
+            units[2] = UNIT_SQUARE + gGridTables.square[other];
+            for (uint8_t uID(0); uID < 3; uID++){
+                if (2 != unitCount[units[uID]]){
+                    continue;
+                }
+
+                for (id = 0; id < VALUE_MAX; id++){
+                    uint8_t pair(gGridTables.units[units[uID]][id]);
+                    if (pair != other && (cands_[pair] & bit)
+                        && !colour[pair]){
+                        colour[pair] = colour[other] ^ 1;
+                        stack[depth++] = pair;
+                    }
+                }
+            }
+        }
+    }
+
+    // Same colour twice in a unit ?
+    uint8_t wrong(0), first, second;
+    for (unit = 0; !wrong && unit < UNIT_COUNT; unit++){
+        for (first = 0; !wrong && first < VALUE_MAX; first++){
+            index = gGridTables.units[unit][first];
+            if (!(cands_[index] & bit)){
+                continue;
+            }
+
+            for (second = first + 1; second < VALUE_MAX; second++){
+                other = gGridTables.units[unit][second];
+                if ((cands_[other] & bit) && colour[other] == colour[index]){
+                    wrong = colour[index];
+                    break;
+                }
+            }
+        }
+    }
+
+    if (wrong){
+        for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+            if (colour[index] == wrong){
+                count += _eliminate(index, bit);
+            }
+        }
+
+        return count;
+    }
+
+    // Positions that see both colours of a chain
+    uint8_t peer, peer2;
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        if (!(cands_[index] & bit)){
+            continue;
+        }
+
+        for (id = 0; id < PEER_COUNT; id++){
+            peer = gGridTables.peers[index][id];
+            if (!(cands_[peer] & bit) || colour[peer] == colour[index]
+                || (colour[peer] ^ 1) == colour[index]){
+                continue;
+            }
+
+            for (other = 0; other < PEER_COUNT; other++){
+                peer2 = gGridTables.peers[index][other];
+                if ((cands_[peer2] & bit)
+                    && colour[peer2] == (colour[peer] ^ 1)){
+                    break;
+                }
+            }
+
+            if (other < PEER_COUNT){
+                count += _eliminate(index, bit);
+                break;
+            }
+        }
+    }
+
+    return count;
+}
+
+// EOF
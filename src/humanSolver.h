@@ -0,0 +1,281 @@
+//----------------------------------------------------------------------
+//--
+//--    humanSolver.h
+//--
+//--        Definition of humanSolver object - Solve a board with
+//--        the techniques used by human players
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_HUMAN_SOLVER_h__
+#define __S_SOLVER_HUMAN_SOLVER_h__    1
+
+#include "consts.h"
+#include "gridTables.h"
+
+// Techniques, from the cheapest to the most expensive
+//
+enum TECHNIQUE_ID{
+    TECH_NAKED_SINGLE = 0,
+    TECH_HIDDEN_SINGLE,
+    TECH_POINTING,
+    TECH_BOX_LINE,
+    TECH_NAKED_PAIR,
+    TECH_X_WING,
+    TECH_HIDDEN_PAIR,
+    TECH_NAKED_TRIPLE,
+    TECH_SWORDFISH,
+    TECH_HIDDEN_TRIPLE,
+    TECH_XY_WING,
+    TECH_COLOURING,
+    TECH_NAKED_QUAD,
+    TECH_HIDDEN_QUAD,
+    TECH_COUNT
+};
+
+#define TECH_NONE       -1      // No technique used
+#define TECH_ALL        (TECH_COUNT - 1)
+
+// Ratings of boards
+//
+#define GRADE_INVALID   -1      // The board can't be solved
+#define GRADE_NONE      0       // No value to find
+#define GRADE_SEARCH    100     // The techniques are not enough
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+//   humanSolver : Solve a board with the techniques of human players
+//
+//      The candidates of each position are a bit mask. Each technique
+//      is a pass on the masks that sets values or removes candidates.
+//      Techniques are tried in cost order : after any progress, the
+//      search restarts with the cheapest one, until none can progress.
+//      No search (guess) is done and no memory is allocated.
+//
+class humanSolver{
+public:
+
+    // Construction
+    humanSolver();
+    humanSolver(const humanSolver&) = delete;
+
+    // Destruction
+    ~humanSolver(){}
+
+    // solve() : Apply the techniques until none can progress
+    //
+    //  @values : values of the board. Will receive the values found
+    //  @maxTech : ID of the most expensive technique allowed
+    //
+    //  @return : # of values found or -1 if the board can't be solved
+    //
+    int8_t solve(uint8_t* values, uint8_t maxTech = TECH_ALL);
+
+    // grade() : Rating of a board
+    //
+    //  The board is solved with the techniques only : its rating is
+    //  the rating of the most expensive technique needed
+    //
+    //  @values : values of the board (left unchanged)
+    //
+    //  @return : rating (x 10), GRADE_NONE, GRADE_SEARCH if the board
+    //          can't be completed or GRADE_INVALID
+    //
+    int8_t grade(const uint8_t* values);
+
+    // solved() : Has the board been completed by the last call to solve() ?
+    //
+    //  @return : true if no position is left empty
+    //
+    bool solved(){
+        return (valid_ && !empties_);
+    }
+
+    // hardest() : Most expensive technique used by the last solve()
+    //
+    //  @return : ID of the technique or TECH_NONE
+    //
+    int8_t hardest(){
+        return hardest_;
+    }
+
+    // uses() : # of times a technique has progressed during the last
+    //          call to solve()
+    //
+    //  @tech : ID of the technique
+    //
+    //  @return : # of uses
+    //
+    uint16_t uses(uint8_t tech){
+        return ((tech < TECH_COUNT)?uses_[tech]:0);
+    }
+
+    // candidates() : Candidates left at a position
+    //
+    //  @index : index of the position
+    //
+    //  @return : bit mask of the candidates (0 if a value is set)
+    //
+    uint16_t candidates(uint8_t index){
+        return cands_[index];
+    }
+
+    // techniqueName() : Name of a technique
+    //
+    //  @tech : ID of the technique
+    //
+    //  @return : the name or NULL if invalid ID
+    //
+    static const char* techniqueName(uint8_t tech);
+
+    // techniqueCost() : Rating of a technique
+    //
+    //  @tech : ID of the technique
+    //
+    //  @return : rating (x 10) or 0 if invalid ID
+    //
+    static uint8_t techniqueCost(uint8_t tech);
+
+private:
+
+    // A technique
+    typedef struct _TECHNIQUE{
+        const char* name;
+        uint8_t cost;       // Rating (x 10)
+        uint16_t (humanSolver::*apply)(uint8_t size);
+        uint8_t size;       // Size of the subset or of the fish
+    }TECHNIQUE;
+
+    // _load() : Copy a board and compute the candidates
+    //
+    //  @values : values of the board
+    //
+    //  @return : false if a value is in conflict with another one
+    //
+    bool _load(const uint8_t* values);
+
+    // _place() : Set a value and remove it from the peers' candidates
+    //
+    //  @index : index of the position
+    //  @value : value to set
+    //
+    void _place(uint8_t index, uint8_t value);
+
+    // _eliminate() : Remove candidates from a position
+    //
+    //  @index : index of the position
+    //  @mask : candidates to remove
+    //
+    //  @return : 1 if candidates have been removed, 0 if unchanged
+    //
+    uint8_t _eliminate(uint8_t index, uint16_t mask){
+        if (!(cands_[index] & mask)){
+            return 0;
+        }
+
+        if (!(cands_[index] &= ~mask)){
+            valid_ = false;     // No candidate left
+        }
+
+        return 1;
+    }
+
+    // _inUnit() : Is a position in a unit ?
+    //
+    //  @index : index of the position
+    //  @unit : ID of the unit
+    //
+    //  @return : true if the position belongs to the unit
+    //
+    bool _inUnit(uint8_t index, uint8_t unit){
+        return ((unit < UNIT_ROW)?(gGridTables.line[index] == unit):
+                ((unit < UNIT_SQUARE)?
+                    (gGridTables.row[index] == unit - UNIT_ROW):
+                    (gGridTables.square[index] == unit - UNIT_SQUARE)));
+    }
+
+    // _isPeer() : Do 2 positions share a unit ?
+    //
+    //  @index : index of the first position
+    //  @other : index of the second position
+    //
+    //  @return : true if they are peers
+    //
+    bool _isPeer(uint8_t index, uint8_t other){
+        return (index != other &&
+                (gGridTables.line[index] == gGridTables.line[other]
+                || gGridTables.row[index] == gGridTables.row[other]
+                || gGridTables.square[index] == gGridTables.square[other]));
+    }
+
+    //
+    // Techniques
+    //
+    //  @size : size of the subset or of the fish (if used)
+    //
+    //  @return : # of changes (values set or candidates removed)
+    //
+
+    // _nakedSingles() : Positions with a single candidate
+    uint16_t _nakedSingles(uint8_t size);
+
+    // _hiddenSingles() : Values with a single position in a unit
+    uint16_t _hiddenSingles(uint8_t size);
+
+    // _pointing() : Candidates of a tinySquare all in the same line
+    //              or row are removed from the rest of this line or row
+    uint16_t _pointing(uint8_t size);
+
+    // _boxLine() : Candidates of a line or row all in the same
+    //              tinySquare are removed from the rest of the tinySquare
+    uint16_t _boxLine(uint8_t size);
+
+    // _nakedSubsets() : @size positions of a unit with only @size
+    //              candidates : they are removed from the rest of the unit
+    uint16_t _nakedSubsets(uint8_t size);
+
+    // _hiddenSubsets() : @size values of a unit that can only be
+    //              at @size positions : the other candidates
+    //              of these positions are removed
+    uint16_t _hiddenSubsets(uint8_t size);
+
+    // _fish() : X-Wing (@size = 2) and Swordfish (@size = 3)
+    uint16_t _fish(uint8_t size);
+
+    // _xyWing() : Pivot {x,y} with pincers {x,z} and {y,z} : z is
+    //              removed from the common peers of the pincers
+    uint16_t _xyWing(uint8_t size);
+
+    // _colouring() : Simple colouring of the conjugate pairs of a value
+    uint16_t _colouring(uint8_t size);
+
+    // _colourValue() : Simple colouring for a single value
+    //
+    //  @value : value
+    //
+    //  @return : # of candidates removed
+    //
+    uint16_t _colourValue(uint8_t value);
+
+    // Members
+private:
+    static const TECHNIQUE techniques_[TECH_COUNT];
+
+    uint8_t values_[VALUES_COUNT];  // Values of the board
+    uint16_t cands_[VALUES_COUNT];  // Candidates of each position
+    uint8_t empties_;               // # of empty positions
+    bool valid_;                    // false if the board can't be solved
+
+    int8_t hardest_;                // Most expensive technique used
+    uint16_t uses_[TECH_COUNT];     // # of uses of each technique
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_HUMAN_SOLVER_h__
+
+// EOF
@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------
+//--
+//--    randomGenerator.cpp
+//--
+//--        Implementation of randomGenerator object - Seeded
+//--        pseudo-random numbers
+//--
+//----------------------------------------------------------------------
+
+#include "randomGenerator.h"
+
+// Odd constant used to spread seeds (2^32 / golden ratio)
+#define SEED_GOLDEN     0x9E3779B9
+
+// __mix() : Mix the bits of a 32 bits number
+//
+//  Close seeds give unrelated sequences
+//
+//  @value : number to mix
+//
+//  @return : mixed value
+//
+static uint32_t __mix(uint32_t value){
+    value ^= (value >> 16);
+    value *= 0x85EBCA6B;
+    value ^= (value >> 13);
+    value *= 0xC2B2AE35;
+    value ^= (value >> 16);
+    return value;
+}
+
+// setSeed() : Restart the sequence
+//
+//  @seed : new seed
+//
+void randomGenerator::setSeed(uint32_t seed){
+    // Each word from a different mix of the seed (never all 0)
+    for (uint8_t index(0); index < RANDOM_STATE_SIZE; index++){
+        seed += SEED_GOLDEN;
+        state_[index] = __mix(seed);
+    }
+}
+
+// seedOf() : Seed of an item in a sequence
+//
+//  @master : seed of the batch
+//  @index : index of the item
+//
+//  @return : seed of the item
+//
+uint32_t randomGenerator::seedOf(uint32_t master, uint32_t index){
+    return __mix(__mix(master) + (index + 1) * SEED_GOLDEN);
+}
+
+// below() : Next number in a range
+//
+//  All the numbers of the range have the same probability : the
+//  multiply-shift method is used and the biased draws are rejected
+//
+//  @count : # of values in the range
+//
+//  @return : a number in [0, @count[ (0 if @count is 0)
+//
+uint32_t randomGenerator::below(uint32_t count){
+    if (count <= 1){
+        return 0;
+    }
+
+    uint64_t product((uint64_t)next() * count);
+    if ((uint32_t)product < count){
+        // Low part in the biased zone ?
+        uint32_t threshold((0 - count) % count);
+        while ((uint32_t)product < threshold){
+            product = (uint64_t)next() * count;
+        }
+    }
+
+    return (uint32_t)(product >> 32);
+}
+
+// shuffle() : Randomly change the order of items (Fisher-Yates)
+//
+//  @items : items to shuffle
+//  @count : # of items
+//
+void randomGenerator::shuffle(uint8_t* items, uint8_t count){
+    uint8_t other, swap;
+    for (uint8_t index(count); index > 1; index--){
+        other = below(index);
+        swap = items[index - 1];
+        items[index - 1] = items[other];
+        items[other] = swap;
+    }
+}
+
+// order() : A random permutation
+//
+//  @order : will receive the numbers in [0, @count[, shuffled
+//  @count : # of items
+//
+void randomGenerator::order(uint8_t* order, uint8_t count){
+    for (uint8_t index(0); index < count; index++){
+        order[index] = index;
+    }
+
+    shuffle(order, count);
+}
+
+// EOF
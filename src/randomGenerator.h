@@ -0,0 +1,120 @@
+//----------------------------------------------------------------------
+//--
+//--    randomGenerator.h
+//--
+//--        Definition of randomGenerator object - Seeded pseudo-random
+//--        numbers
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_RANDOM_GENERATOR_h__
+#define __S_SOLVER_RANDOM_GENERATOR_h__    1
+
+#include "consts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+#define RANDOM_STATE_SIZE   4   // # of 32 bits words of the state
+
+//   randomGenerator : Pseudo-random numbers (xoshiro128**)
+//
+//      The sequence only depends on the seed : unlike rand(), each
+//      object has its own state and the same seed always gives the
+//      same numbers, on any platform.
+//      Only 32 bits operations are used (fast on SH4).
+//
+class randomGenerator{
+public:
+
+    // Construction
+    //
+    //  @seed : initial seed
+    //
+    randomGenerator(uint32_t seed = 0){
+        setSeed(seed);
+    }
+
+    // Destruction
+    ~randomGenerator(){}
+
+    // setSeed() : Restart the sequence
+    //
+    //  @seed : new seed
+    //
+    void setSeed(uint32_t seed);
+
+    // seedOf() : Seed of an item in a sequence
+    //
+    //  Each item of a batch gets its own seed : the result of an item
+    //  doesn't depend on the order in which the items are generated
+    //
+    //  @master : seed of the batch
+    //  @index : index of the item
+    //
+    //  @return : seed of the item
+    //
+    static uint32_t seedOf(uint32_t master, uint32_t index);
+
+    // next() : Next number of the sequence
+    //
+    //  @return : a 32 bits number
+    //
+    uint32_t next(){
+        uint32_t result(_rotl(state_[1] * 5, 7) * 9);
+        uint32_t t(state_[1] << 9);
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = _rotl(state_[3], 11);
+        return result;
+    }
+
+    // below() : Next number in a range
+    //
+    //  All the numbers of the range have the same probability
+    //
+    //  @count : # of values in the range
+    //
+    //  @return : a number in [0, @count[ (0 if @count is 0)
+    //
+    uint32_t below(uint32_t count);
+
+    // shuffle() : Randomly change the order of items (Fisher-Yates)
+    //
+    //  @items : items to shuffle
+    //  @count : # of items
+    //
+    void shuffle(uint8_t* items, uint8_t count);
+
+    // order() : A random permutation
+    //
+    //  @order : will receive the numbers in [0, @count[, shuffled
+    //  @count : # of items
+    //
+    void order(uint8_t* order, uint8_t count);
+
+private:
+
+    // _rotl() : Rotate bits to the left
+    //
+    static uint32_t _rotl(uint32_t value, uint8_t count){
+        return (value << count) | (value >> (32 - count));
+    }
+
+    // Members
+private:
+    uint32_t state_[RANDOM_STATE_SIZE];     // Never all 0
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_RANDOM_GENERATOR_h__
+
+// EOF
@@ -100,8 +100,11 @@ int bFile::size(){
         error_ = BFILE_NO_ERROR;
         return ret;
 #else
+        std::streampos pos(file_.tellg());
         file_.seekg (0, file_.end);
-        return file_.tellg();
+        int size(file_.tellg());
+        file_.seekg(pos);   // Next read() is unchanged
+        return size;
 #endif // #ifdef DEST_CASIO_CALC
     }
 
@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------
+//--
+//--    solverEngine.cpp
+//--
+//--        Registry of the available solver engines
+//--
+//----------------------------------------------------------------------
+
+#include "solverEngine.h"
+#include "backtrackEngine.h"
+#include "dlxSolver.h"
+
+#include <string.h>
+
+// Registered engines
+//
+static backtrackEngine __linearEngine(SEARCH_MODE_LINEAR);
+static backtrackEngine __mrvEngine(SEARCH_MODE_MRV);
+static dlxSolver __dlxEngine;
+static backtrackEngine __propagateEngine(SEARCH_MODE_PROPAGATE);
+
+static solverEngine* const __engines[SEARCH_MODE_COUNT] = {
+    &__linearEngine, &__mrvEngine, &__dlxEngine, &__propagateEngine};
+
+// engine() : Get a registered engine
+//
+//  @id : ID of the engine (a SEARCH_MODE value)
+//
+//  @return : pointer to the engine or NULL if @id is invalid
+//
+solverEngine* solverEngine::engine(uint8_t id){
+    return ((id < SEARCH_MODE_COUNT)?__engines[id]:NULL);
+}
+
+// find() : Find a registered engine by its name
+//
+//  @name : name of the engine
+//
+//  @return : ID of the engine or -1 if not found
+//
+int8_t solverEngine::find(const char* name){
+    if (name){
+        for (uint8_t id(0); id < SEARCH_MODE_COUNT; id++){
+            if (!strcmp(name, __engines[id]->name())){
+                return id;
+            }
+        }
+    }
+
+    return -1;
+}
+
+// checkBudget() : Count a new node and check the limits of a budget
+//
+//  @budget : limits and statistics of the searches
+//
+//  @return : true if the budget is exhausted
+//
+bool solverEngine::checkBudget(SEARCH_BUDGET& budget){
+    if (!budget.exhausted){
+        budget.nodes++;
+        budget.exhausted =
+            ((budget.maxNodes && budget.nodes > budget.maxNodes)
+            || (budget.cancel && *budget.cancel)
+            || (budget.deadline
+                && !(budget.nodes % SEARCH_CLOCK_PERIOD)
+                && clock() >= budget.deadline));
+    }
+
+    return budget.exhausted;
+}
+
+// EOF
@@ -0,0 +1,202 @@
+//----------------------------------------------------------------------
+//--
+//--    solverEngine.h
+//--
+//--        Definition of solverEngine object - Common interface
+//--        of the solvers and registry of the available engines
+//--
+//----------------------------------------------------------------------
+
+#ifndef __S_SOLVER_SOLVER_ENGINE_h__
+#define __S_SOLVER_SOLVER_ENGINE_h__    1
+
+#include "consts.h"
+
+// Registered engines
+//
+//  IDs are the search modes used by sudoku::setSearchMode()
+//
+enum SEARCH_MODE{
+    SEARCH_MODE_LINEAR = 0, // Walk forward through the grid, in index order
+    SEARCH_MODE_MRV = 1,    // Branch on the most constrained position first
+    SEARCH_MODE_DLX = 2,    // Exact cover search (dancing links)
+    SEARCH_MODE_PROPAGATE = 3,  // MRV with obvious values set after each try
+    SEARCH_MODE_COUNT = 4
+};
+
+// Engine used by default
+//  (can be changed at compile time)
+//
+#ifndef SOLVER_ENGINE_DEFAULT
+#define SOLVER_ENGINE_DEFAULT   SEARCH_MODE_PROPAGATE
+#endif // #ifndef SOLVER_ENGINE_DEFAULT
+
+// Result of a search stopped before its end
+//
+#define SEARCH_EXHAUSTED    (-2)
+
+// The deadline is checked every SEARCH_CLOCK_PERIOD nodes
+//
+#define SEARCH_CLOCK_PERIOD 64
+
+// Limits of searches
+//
+//  The same budget can be used by many searches. Limits are then
+//  for all the searches
+//
+typedef struct _SEARCH_BUDGET{
+    // Limits (0 or NULL for no limit)
+    uint32_t maxNodes;          // Max. # of nodes explored
+    clock_t deadline;           // Value of clock() when the search stops
+    volatile bool* cancel;      // The search stops when *cancel is true
+
+    // Statistics
+    uint32_t nodes;             // # of nodes tried (with the one that
+                                //  stopped the search)
+    uint8_t solutions;          // # of solutions found by the last search
+    bool exhausted;             // Has a search been stopped ?
+}SEARCH_BUDGET;
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+//   solverEngine : Search for the solutions of a grid
+//
+//      All the engines work on a compact board : a table of
+//      VALUES_COUNT values, EMPTY_VALUE for empty elements.
+//      An engine has no link with the edition nor the display of a grid
+//
+class solverEngine{
+public:
+
+    // Construction
+    solverEngine(){
+        nodes_ = 0;
+        budget_ = NULL;
+    }
+
+    // Destruction
+    virtual ~solverEngine(){}
+
+    // name() : Name of the engine
+    //
+    //  @return : the name
+    //
+    virtual const char* name() = 0;
+
+    // solve() : Find a solution for a board
+    //
+    //  @values : values of the board. Will receive the values
+    //          of the solution if one is found
+    //
+    //  @return : true if a solution was found
+    //
+    virtual bool solve(uint8_t* values) = 0;
+
+    // countSolutions() : Count the solutions of a board
+    //
+    //  @values : values of the board
+    //  @limit : max. # of solutions to search for
+    //
+    //  @return : # of solutions found (at most @limit)
+    //
+    virtual uint8_t countSolutions(const uint8_t* values, uint8_t limit) = 0;
+
+    // propagate() : Set the obvious values of a board until none
+    //              can be found
+    //
+    //  @values : values of the board. Will receive the obvious values
+    //
+    //  @return : # of obvious values set or -1 if the board
+    //            can't be solved
+    //
+    virtual int8_t propagate(uint8_t* values) = 0;
+
+    // nodes() : # of values tried during the last search
+    //
+    //  @return : count of "search nodes"
+    //
+    uint32_t nodes(){
+        return nodes_;
+    }
+
+    // setBudget() : Set the limits of the next searches
+    //
+    //  The engines of the registry are shared : a caller sets its
+    //  budget before its searches and resets it (NULL) when done
+    //
+    //  @budget : limits and statistics of the searches.
+    //          NULL for unlimited searches
+    //
+    void setBudget(SEARCH_BUDGET* budget){
+        budget_ = budget;
+    }
+
+    // exhausted() : Has the last search been stopped before its end ?
+    //
+    //  @return : true if the budget is exhausted
+    //
+    bool exhausted(){
+        return (budget_ && budget_->exhausted);
+    }
+
+    //
+    // Registry
+    //
+
+    // engine() : Get a registered engine
+    //
+    //  @id : ID of the engine (a SEARCH_MODE value)
+    //
+    //  @return : pointer to the engine or NULL if @id is invalid
+    //
+    static solverEngine* engine(uint8_t id);
+
+    // find() : Find a registered engine by its name
+    //
+    //  @name : name of the engine
+    //
+    //  @return : ID of the engine or -1 if not found
+    //
+    static int8_t find(const char* name);
+
+    // checkBudget() : Count a new node and check the limits of a budget
+    //
+    //  @budget : limits and statistics of the searches
+    //
+    //  @return : true if the budget is exhausted
+    //
+    static bool checkBudget(SEARCH_BUDGET& budget);
+
+protected:
+
+    // _overBudget() : Count a new node and check the limits
+    //
+    //  @return : true if the search must stop
+    //
+    bool _overBudget(){
+        return (budget_ && _checkBudget());
+    }
+
+    // _checkBudget() : Count a new node and check the limits
+    //
+    //  @return : true if the budget is exhausted
+    //
+    bool _checkBudget(){
+        return checkBudget(*budget_);
+    }
+
+    // Members
+protected:
+    uint32_t nodes_;
+    SEARCH_BUDGET* budget_;     // Limits of the search
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __S_SOLVER_SOLVER_ENGINE_h__
+
+// EOF
@@ -17,6 +17,8 @@ extern bopti_image_t g_about;
 //
 sudoSolver::sudoSolver(){
     _initStats();
+    generator_.setSeed((uint32_t)clock(), 1);   // Not the grids of game_
+    lastAction_ = clock();
 }
 
 // createMenu() : Create app. menu bar
@@ -87,6 +89,12 @@ void sudoSolver::browseGridFolder(){
     capture_.resume();
 
     if (count >= 0){
+        if (files_.duplicates()){
+            dprint(TEXT_V_BASE, FILE_TEXT_ERROR_Y, C_RED,
+                    FILE_DUPLICATES_TEXT, files_.duplicates());
+            dupdate();
+        }
+
         _updateFileItemsState();
     }
 }
@@ -102,6 +110,9 @@ void sudoSolver::run(void)
 
     game_.setScreenRect(&mainRect); // "screen" dim for sudoku grid
 
+    pool_.load();   // Grids created during previous sessions
+    lastAction_ = clock();
+
     // Handle user's choices
     bool end(false);
     MENUACTION action;
@@ -109,6 +120,13 @@ void sudoSolver::run(void)
         // A menu action ?
         action = menu_.handleKeyboard();
 
+        if (ACTION_KEYBOARD == action.type && KEY_CODE_NONE == action.value){
+            _onIdle();
+            continue;
+        }
+
+        lastAction_ = clock();
+
         // push a menu key ?
         if (ACTION_MENU == action.type){
             switch (action.value){
@@ -213,6 +231,8 @@ void sudoSolver::run(void)
             }
         }
     }
+
+    pool_.save();
 }
 
 //
@@ -238,6 +258,18 @@ void sudoSolver::_onNewEmpty(){
 //  @compelxity : complexity of the grid to create
 //
 void sudoSolver::_onNewSudoku(uint8_t complexity){
+    GRID grid;
+    if (pool_.pop(complexity, &grid)){
+        // A grid is ready
+        game_.empty();
+        game_.setElements(&grid);
+        game_.display();
+
+        _initStats();
+        _updateFileItemsState();
+        return;
+    }
+
     window waitWindow;
     window::winInfo wInf;
     wInf.style = WIN_STYLE_DEFAULT;
@@ -258,6 +290,24 @@ void sudoSolver::_onNewSudoku(uint8_t complexity){
     _updateFileItemsState();
 }
 
+// _onIdle() : No key pressed
+//  Refill the pool of grids when idle for a while
+//
+void sudoSolver::_onIdle(){
+    if (pool_.full() ||
+        (clock() - lastAction_) < (clock_t)(POOL_IDLE_DELAY * CLOCKS_PER_SEC)){
+        return;
+    }
+
+    // The creation is stopped when the slice is over
+    SEARCH_BUDGET budget;
+    memset(&budget, 0, sizeof(budget));
+    budget.deadline = clock() + POOL_SLICE_DURATION * CLOCKS_PER_SEC;
+    pool_.refill(generator_, budget);
+
+    lastAction_ = clock();  // Next slice after a new delay
+}
+
 // _onFilePrevious() : Open previous file in the grid folder
 //
 void sudoSolver::_onFilePrevious(){
@@ -285,12 +335,26 @@ void sudoSolver::_onFileSave(){
     int uid(-1);
     int error(FILE_NO_ERROR);
 
+    // Already in the folder (even transformed) ?
+    uint8_t values[VALUES_COUNT];
+    game_.originalValues(values);
+    int same(files_.findGrid(values, fileExists?files_.pos():-1));
+    if (-1 != same){
+        dprint(FILE_TEXT_X, FILE_TEXT_ERROR_Y, C_RED,
+                FILE_DUPLICATE_TEXT, same);
+        dupdate();
+        return;
+    }
+
     // Use current name or new name if none
     uint16_t fName[BFILE_MAX_PATH + 1];
     FC_EMPTY(fName);
     if (fileExists || (!fileExists && files_.getNewFileName(fName, &uid))){
         if (FILE_NO_ERROR == (error = game_.save(fName))){
-            if (!fileExists){
+            if (fileExists){
+                files_.setGrid(files_.pos(), values);
+            }
+            else{
                 // It's a new file
                 _newFileName(fName);
 
@@ -370,6 +434,7 @@ void sudoSolver::_onSolveManual(){
 void sudoSolver::_onSolveFindObvious(){
     obviousVals_ = game_.findObviousValues();
     duration_ = -1;
+    nodes_ = -1;
     game_.display(false);
     _displayStats();
 }
@@ -383,6 +448,7 @@ void sudoSolver::_onFindSolution(){
         // ... return to original grid
         game_.revert();
     }
+    nodes_ = game_.nodes();
 
     game_.display(false);
     _displayStats();
@@ -395,6 +461,7 @@ void sudoSolver::_onRevert(){
     game_.display(false);
     obviousVals_ = -1;
     duration_ = -1;
+    nodes_ = -1;
     _displayStats();
 }
 
@@ -431,6 +498,13 @@ bool sudoSolver::_loadFile(FONTCHARACTER fName){
         game_.display(false);
         _newFileName(fName);
         _updateFileItemsState();
+
+        int same(files_.duplicateOf(files_.pos()));
+        if (-1 != same){
+            dprint(FILE_TEXT_X, FILE_TEXT_ERROR_Y, C_RED,
+                    FILE_DUPLICATE_TEXT, same);
+            dupdate();
+        }
         return true;
     }
 
@@ -453,6 +527,7 @@ void sudoSolver::_initStats(bool whole){
 
     obviousVals_ = -1;
     duration_ = -1;
+    nodes_ = -1;
 }
 
 // _updateFileItemsState() : Item's state
@@ -517,6 +592,10 @@ void sudoSolver::_displayStats(){
         }
     }
 
+    if (nodes_ != -1){
+        dprint(NODES_X, NODES_Y, C_BLACK, NODES_TEXT, nodes_);
+    }
+
     dupdate();
 }
 
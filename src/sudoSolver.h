@@ -13,6 +13,7 @@
 
 #include "menus.h"
 #include "grids.h"
+#include "gridPool.h"
 #include "sudoku.h"
 
 #include "shared/scrCapture.h"
@@ -95,6 +96,11 @@ private:
     //
     void _onCapture();
 
+    // _onIdle() : No key pressed
+    //  Refill the pool of grids when idle for a while
+    //
+    void _onIdle();
+
     // _loadFile() : Load and display a grid
     //
     //  @fName : File to load
@@ -134,12 +140,17 @@ private:
 
     sudoku      game_;      // the solver ...
 
+    gridPool    pool_;      // Grids ready to be played
+    sudoku      generator_; // ... and their creator
+    clock_t     lastAction_;    // Time of the last key pressed
+
     // Current file name
     uint16_t fileName_[BFILE_MAX_PATH + 1];
 
     // Resolution stats.
     int8_t obviousVals_;
     int duration_;
+    int nodes_;
 
     scrCapture capture_;   // Screen capture object
 };
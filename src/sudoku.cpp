@@ -13,6 +13,7 @@
 #include "shared/keyboard.h"
 
 #include "sudokuShuffler.h"
+#include "sudokuSolutions.h"
 
 #include <time.h>
 #include <math.h>
@@ -47,23 +48,28 @@ sudoku::sudoku(){
 
     // No help (yet)
     helpClues_ = MAX_HELP_CLUES;
+
+    searchMode_ = SOLVER_ENGINE_DEFAULT;
+    nodes_ = 0;
+    budget_ = NULL;     // No limit
+    random_.setSeed((uint32_t)clock());
 }
 
 // Copy constructor
 //
 sudoku::sudoku(sudoku& original)
 :sudoku(){
-    setElements(original.elements_);    // copy the grid
+    setElements(&original.grid_);   // copy the grid
 }
 
 // setElments() : set elements of the grid
 //
-//  @elements : list of elements
+//  @grid : values, status and hyp. of the elements
 //
-void sudoku::setElements(element* elements){
-    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
-        elements_[index] = elements[index];
-    }
+void sudoku::setElements(const GRID* grid){
+    memcpy(&grid_, grid, sizeof(GRID));
+
+    _updateMasks();
 }
 
 // setScreenRect() : Screen dimensions
@@ -99,23 +105,22 @@ void sudoku::display(bool update){
     }
 #else
     position pos(0, false);
-    element* pElement(NULL);
     char car;
     for (uint8_t line(0); line < LINE_COUNT; line++){
         cout << "\t";
 
         for (uint8_t row(0); row < ROW_COUNT; row++){
-            pElement = &elements_[pos];
+            element current(_element(pos));
             car = '0';
-            if (!pElement->isEmpty()){
-                car += pElement->value();
+            if (!current.isEmpty()){
+                car += current.value();
             }
 
             cout << car << " - ";
 
             // Colour ?
-            if (pElement->hypColour() != HYP_NO_COLOUR){
-                car = (char)(pElement->hypColour());
+            if (current.hypColour() != HYP_NO_COLOUR){
+                car = (char)(current.hypColour());
                 cout << car;
             }
             else{
@@ -151,9 +156,13 @@ void sudoku::displayFileName(){
 //
 void sudoku::empty(){
     _freeSoluce();
-    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX ; index++){
-        elements_[index].empty();
-    }
+    memset(&grid_, 0, sizeof(GRID));    // Empty elements, no hyp.
+
+    // No more used values
+    memset(lineMasks_, 0, sizeof(lineMasks_));
+    memset(rowMasks_, 0, sizeof(rowMasks_));
+    memset(squareMasks_, 0, sizeof(squareMasks_));
+    valuesCount_ = 0;
 
     emptyFileName();
 }
@@ -204,15 +213,38 @@ void sudoku::pause(){
 //  @return : # of clues (ie of non empty elements) or -1 on error
 //
 int sudoku::create(uint8_t complexity){
+    SEARCH_BUDGET budget = {0, 0, NULL, 0, 0, false};   // No limit
+    return create(complexity, budget);
+}
+
+// create() : Create a new sudoku with limited searches
+//
+//  When the budget is exhausted, the grid may be incomplete.
+//  The budget is only used during the call
+//
+//  @complexity : Complexity level in {}
+//  @budget : limits and statistics of all the searches
+//
+//  @return : # of clues, -1 on error or SEARCH_EXHAUSTED
+//
+int sudoku::create(uint8_t complexity, SEARCH_BUDGET& budget){
     if (complexity < INDEX_MAX){
-        uint8_t clues(0);
-        while ((clues = _create(complexity)) > COMPLEXITY_EASY){}
+        _setBudget(&budget);
+
+        // Keep the last grid if too many attempts
+        uint8_t clues(0), attempts(0);
+        do{
+            clues = _create(complexity);
+        } while (!budget.exhausted && clues > COMPLEXITY_EASY
+                && ++attempts < CREATE_ATTEMPTS_MAX);
+
+        _setBudget(NULL);
 
 #ifndef DEST_CASIO_CALC
         cout << endl << "Clues : " << (int)clues << endl;
 #endif // #ifndef DEST_CASIO_CALC
 
-        return clues;
+        return (budget.exhausted?SEARCH_EXHAUSTED:clues);
     }
 
     return -1;
@@ -226,6 +258,43 @@ int sudoku::create(uint8_t complexity){
 //
 uint8_t sudoku::load(const FONTCHARACTER fName){
     emptyFileName();
+
+    uint8_t values[VALUES_COUNT];
+    uint8_t error(readValues(fName, values));
+    if (FILE_NO_ERROR != error){
+        return error;
+    }
+
+    empty();    // restart with an empty grid
+
+    // Set the values
+    position pos(INDEX_MIN, false);  // Begining ot matrix
+    uint8_t value;
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        if ((value = values[index]) && _checkValue(pos, value)){
+            // This value is valid at this position and is ORIGINAL
+            _setValue(pos, value, STATUS_ORIGINAL);
+        }
+
+        // next element
+        pos++;
+    }
+
+    // The new grid is valid
+    _newFileName(fName);
+    return FILE_NO_ERROR;
+}
+
+// readValues() : Read the values of a grid file
+//
+//  Values are not checked
+//
+//  @fName : file to read
+//  @values : will receive the values
+//
+//  @return : 0 on success or an error code
+//
+uint8_t sudoku::readValues(const FONTCHARACTER fName, uint8_t* values){
     if (!fName || !fName[0]){
         return FILE_NO_FILENAME;
     }
@@ -243,37 +312,36 @@ uint8_t sudoku::load(const FONTCHARACTER fName){
     }
 
     iFile.close();
-    empty();    // restart with an empty grid
 
     // Parse the buffer
-    position pos(INDEX_MIN, false);  // Begining ot matrix
     char car;
-    uint8_t value, index(0);
-    while (index < FILE_SIZE){
+    uint8_t index(0);
+    for (uint8_t pos(INDEX_MIN); pos <= INDEX_MAX; pos++){
         car = buffer[index++]; // "value"
         if (car >= '0' and car <= '9'){
-            value = (uint8_t)(car - '0');
-            if (value && _checkValue(pos, value)){
-                // This value is valid at this position and is ORIGINAL
-                elements_[pos].setValue(value, STATUS_ORIGINAL);
-            }
+            values[pos] = (uint8_t)(car - '0');
         }
         else{
             return FILE_INVALID_FORMAT;
         }
 
-        // separator
-        car = buffer[index++];
-
-        // next element
-        pos++;
+        index++;    // separator
     }
 
-    // The new grid is valid
-    _newFileName(fName);
     return FILE_NO_ERROR;
 }
 
+// originalValues() : Get the "original" values of the grid
+//
+//  @values : will receive the values (EMPTY_VALUE if not original)
+//
+void sudoku::originalValues(uint8_t* values){
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        values[index] = (_element(index).isOriginal()?
+                            _element(index).value():EMPTY_VALUE);
+    }
+}
+
 // save() : Save the grid on a file
 //
 //  In the given grid, only "original" values
@@ -295,8 +363,8 @@ int sudoku::save(const FONTCHARACTER fName){
     for (uint8_t lId(0); lId < LINE_COUNT; lId++){
         for (uint8_t cId(0); cId < ROW_COUNT; cId++){
             // '0' means empty !
-            buffer[2*index] = (elements_[index].isOriginal()?
-                        ('0' + elements_[index].value()):'0');
+            buffer[2*index] = (_element(index).isOriginal()?
+                        ('0' + _element(index).value()):'0');
             buffer[2*index+1] = VALUE_SEPARATOR;
             index++;
         }
@@ -349,7 +417,6 @@ bool sudoku::edit(uint8_t mode){
     bool cont(true);
     bool showSelected(true);
     bool reDraw(false);
-    int eStatus;
     int8_t index;
 
     position currentPos(0, false);
@@ -372,13 +439,7 @@ bool sudoku::edit(uint8_t mode){
     dupdate();
 
     // # Values in the grid
-    uint8_t values(0), oValues(0);
-    for (index = INDEX_MIN; index<=INDEX_MAX ; index++){
-        if (!elements_[index].isEmpty()){
-            values++;
-        }
-    }
-    oValues = values;
+    uint8_t oValues(valuesCount_);
 
     // Timer for blinking effect
     int tickCount(BLINK_TICKCOUNT);
@@ -437,8 +498,7 @@ bool sudoku::edit(uint8_t mode){
         //
         case KEY_CODE_0:
             // Remove the value
-            if (elements_[currentPos].empty()){
-                values--; // one less element
+            if (_emptyValue(currentPos)){
                  modified = true;
 
                  // First colored element ?
@@ -450,65 +510,56 @@ bool sudoku::edit(uint8_t mode){
             break;
 
         case KEY_CODE_1:
-            if ((eStatus = _checkAndSet(currentPos, 1, mode)) >= 0){
+            if (_checkAndSet(currentPos, 1, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_2:
-            if ((eStatus = _checkAndSet(currentPos, 2, mode)) >= 0){
+            if (_checkAndSet(currentPos, 2, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_3:
-            if ((eStatus = _checkAndSet(currentPos, 3, mode)) >= 0){
+            if (_checkAndSet(currentPos, 3, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_4:
-            if ((eStatus = _checkAndSet(currentPos, 4, mode)) >= 0){
+            if (_checkAndSet(currentPos, 4, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_5:
-            if ((eStatus = _checkAndSet(currentPos, 5, mode)) >= 0){
+            if (_checkAndSet(currentPos, 5, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_6:
-            if ((eStatus = _checkAndSet(currentPos, 6, mode)) >= 0){
+            if (_checkAndSet(currentPos, 6, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_7:
-            if ((eStatus = _checkAndSet(currentPos, 7, mode)) >= 0){
+            if (_checkAndSet(currentPos, 7, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_8:
-            if ((eStatus = _checkAndSet(currentPos, 8, mode)) >= 0){
+            if (_checkAndSet(currentPos, 8, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
         case KEY_CODE_9:
-            if ((eStatus = _checkAndSet(currentPos, 9, mode)) >= 0){
+            if (_checkAndSet(currentPos, 9, mode) >= 0){
                 modified = true;
-                values+=eStatus;
             }
             break;
 
@@ -539,8 +590,6 @@ bool sudoku::edit(uint8_t mode){
         {
             uint8_t count;
             if ((count = _onManualReject())){
-                values-=count;
-
                 if (-1 != hypotheses_[hypID_].firstPos){
                     // Move to  element at 'first' pos.
                     currentPos = hypotheses_[hypID_].firstPos;
@@ -606,7 +655,7 @@ bool sudoku::edit(uint8_t mode){
             }
 
             // # values
-            if (oValues != values){
+            if (oValues != valuesCount_){
                 /*
                 drect(VALUES_X, VALUES_Y,
                     CASIO_WIDTH - 1,
@@ -616,11 +665,11 @@ bool sudoku::edit(uint8_t mode){
                 dprint_opt(VALUES_X, VALUES_Y,
                     C_BLACK, SCREEN_BK_COLOUR,
                     DTEXT_LEFT, DTEXT_TOP,
-                    VALUES_TEXT, values, ROW_COUNT * LINE_COUNT);
+                    VALUES_TEXT, valuesCount_, ROW_COUNT * LINE_COUNT);
 
-                oValues = values;
+                oValues = valuesCount_;
 
-                if (values >= VALUES_COUNT){
+                if (valuesCount_ >= VALUES_COUNT){
                     cont = false;   // No more value to find
                 }
             }
@@ -636,7 +685,7 @@ bool sudoku::edit(uint8_t mode){
     }
 
     // Completed ?
-    if (values >= VALUES_COUNT){
+    if (valuesCount_ >= VALUES_COUNT){
         window popup;
         window::winInfo wInf;
         wInf.style = WIN_STYLE_DBORDER | WIN_STYLE_HCENTER;
@@ -658,7 +707,7 @@ bool sudoku::edit(uint8_t mode){
     // Remove all coloured hyp.
     if (EDIT_MODE_MANUAL == mode){
         for (uint8_t index(INDEX_MIN); index<=INDEX_MAX ; index++){
-            elements_[index].setHypColour(HYP_NO_COLOUR);
+            _element(index).setHypColour(HYP_NO_COLOUR);
         }
 
         // Redraw the whole grid
@@ -681,21 +730,31 @@ bool sudoku::edit(uint8_t mode){
 //  @return : #obvious values found
 //
 uint8_t sudoku::findObviousValues(){
-    uint8_t found(0), values(0);
-    do{
-        values = _findObviousValues();
-        found += values;
-    } while(values);    // since we found value(s), we'll search new ones
+    uint8_t values[VALUES_COUNT];
+    _copyValues(values);
+
+    solverEngine* engine(_engine());
+    if (engine->propagate(values) <= 0){
+        return 0;   // None found or the grid can't be solved
+    }
+
+    uint8_t found(0);
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        if (EMPTY_VALUE == grid_.values[index] && values[index]){
+            // One more obvious value !!!!
+            _setValue(index, values[index], STATUS_OBVIOUS);
+            found++;
+        }
+    }
 
     return found;
 }
 
 // resolve() : Find a solution for the current grid
 //
-//  The algorithm will go forward to seek value and backward each
-//  time a value can't be found at a given pos.
-//  When going backward, if position reaches sPos (if not NULL)
-//  or exits the grid, the method ends with no solution.
+//  The search is done on a copy of the values by the engine of the
+//  current search mode (searchMode_, see setSearchMode()). The values
+//  found are then set in the grid.
 //
 //  @mDuration : points to an int that will receive duration
 //              of solving process in ms. Can be NULL
@@ -725,7 +784,8 @@ bool sudoku::resolve(int* mDuration, int8_t** soluce){
     waitWindow.update();
 #endif // #ifdef DEST_CASIO_CALC
 
-    bool found(_resolve(INDEX_MIN)); // Try to find the first solution
+    // Try to find the first solution
+    bool found(_solve());
 
     // Copy duration
     if (mDuration){
@@ -747,58 +807,84 @@ bool sudoku::resolve(int* mDuration, int8_t** soluce){
     return found;
 }
 
-// findNextStartPos() : Find the next "starting" postion
-//
-//  This enables to search for another solution or check wether
-//  a found solution is unique or not
+// resolve() : Find a solution for the current grid with a limited search
 //
-//  @start : Position to search from
-//          @start will point to the new position has been found
-//  @startVal : New starting value
+//  @budget : limits and statistics of the search
 //
-//  @return : true if a valid position has been found
+//  @return : 1 if a solution was found, 0 if the grid has no solution
+//          or SEARCH_EXHAUSTED if the search has been stopped
 //
-bool sudoku::findNextStartPos(position &start, int8_t& startVal){
-    int8_t elements[INDEX_MAX+1];
-    _copyElements(elements);       // Keep a copy of current completed grid
+int8_t sudoku::resolve(SEARCH_BUDGET& budget){
+    _setBudget(&budget);
+    bool found(resolve());
+    _setBudget(NULL);
+    return (found?1:(budget.exhausted?SEARCH_EXHAUSTED:0));
+}
 
-    bool found(false);
-    startVal = -1; // Error
+// countSolutions() : Count the solutions of the grid
+//
+//  The search is done in a single pass and stops as soon as @limit
+//  solutions have been found. The grid is left unchanged.
+//
+//  @limit : max. # of solutions to search for
+//
+//  @return : # of solutions found (at most @limit)
+//
+uint8_t sudoku::countSolutions(uint8_t limit){
+    uint8_t values[VALUES_COUNT];
+    _copyValues(values);
 
-    if (POS_VALID == start.status()){
-        position next(start);
-        int8_t oValue(elements_[next].value());
-        int8_t value(oValue + 1);   // Next value
+    solverEngine* engine(_engine());
+    uint8_t count(engine->countSolutions(values, limit));
+    nodes_ = engine->nodes();
+    return count;
+}
 
-        _revertFrom(next);
+// countSolutions() : Count the solutions of the grid with a limited
+//                  search
+//
+//  @limit : max. # of solutions to search for
+//  @budget : limits and statistics of the search. On exhaustion,
+//          budget.solutions is the # of solutions already found
+//
+//  @return : # of solutions found (at most @limit) or SEARCH_EXHAUSTED
+//
+int8_t sudoku::countSolutions(uint8_t limit, SEARCH_BUDGET& budget){
+    _setBudget(&budget);
+    uint8_t count(countSolutions(limit));
+    _setBudget(NULL);
+    return (budget.exhausted?SEARCH_EXHAUSTED:count);
+}
 
-        while (!found && next < INDEX_MAX){
-            if (value <= VALUE_MAX){
-                if (false == (found = _checkValue(next, value))){
-                    // Try next value
-                    value++;
-                }
-            }
-            else{
-                // Put back previous val.
-                elements_[next].setValue(oValue);
-
-                // Try next pos (ie. next "set" value)
-                while (++next < INDEX_MAX){
-                    if (elements[next] < 0){
-                        value = -1 * elements[next] + 1;
-                    }
-                }
-            }
-        }
+// grade() : Rating of the grid
+//
+//  @hardest : points to an int8_t that will receive the ID
+//          of the most expensive technique used. Can be NULL
+//
+//  @return : rating (x 10), GRADE_NONE, GRADE_SEARCH if the grid
+//          can't be completed with these techniques or GRADE_INVALID
+//
+int8_t sudoku::grade(int8_t* hardest){
+    uint8_t values[VALUES_COUNT];
+    _copyValues(values);
 
-        if (found){
-            start = next;    // (new or not) stating pos.
-            startVal = value;   // New starting value
-        }
+    humanSolver solver;
+    int8_t rating(solver.grade(values));
+    if (hardest){
+        (*hardest) = solver.hardest();
     }
 
-    return found;   // ?
+    return rating;
+}
+
+// solutions() : Enumerate the solutions of the grid
+//
+//  @return : an object that searches for the solutions one at a time
+//
+sudokuSolutions sudoku::solutions(){
+    uint8_t values[VALUES_COUNT];
+    _copyValues(values);
+    return sudokuSolutions(values);
 }
 
 // multipleSolutions() : Check wether a grid has one or many solutions
@@ -810,36 +896,8 @@ bool sudoku::findNextStartPos(position &start, int8_t& startVal){
 //            been found -1 if many solutions may be founded (2 at least).
 //
 int sudoku::multipleSolutions(){
-    int count(0);
-    position start(INDEX_MIN), valid(INDEX_MIN);
-    int8_t newVal(0);
-    bool finished(false);
-
-    while (!finished && _resolve(&start)){
-        if (count++){
-            // Found 2 solutions => stop searchning
-            return -1;
-        }
-
-        // Search next element to change
-        while (elements_[valid].isOriginal()){
-            valid++;
-        }
-        start = valid;
-
-        sudoku next(*this);
-        if (next.findNextStartPos(start, newVal)){
-            _revertFrom(start);   // remove previously founded vals
-            elements_[start].setValue(newVal, STATUS_SET);
-            valid = start;
-        }
-        else{
-            // No more starting pos.
-            finished = true;
-        }
-    }
-
-    return count;
+    uint8_t count(countSolutions(2));
+    return ((count > 1)?-1:count);
 }
 
 //
@@ -855,62 +913,47 @@ int sudoku::multipleSolutions(){
 uint8_t sudoku::_create(uint8_t complexity){
     // step 1 : start from a complete grid
     empty();
-    resolve();
-
-    // step 2 : shuffles elements
-    sudokuShuffler shuffler(elements_);
-    shuffler.shuffleValues();
-
-    // step 3 : rearrange columns
-    shuffler.shuffleColumns();
-
-    // step 4: rearrange rows
-    shuffler.shuffleRows();
+    if (!_solve()){
+        return 0;       // Budget exhausted
+    }
 
-    // step 5 : rearrange block of columns
-    shuffler.shuffleColumnBlocks();
+    // step 2 : shuffle values, lines, columns and their blocks
+    sudokuShuffler shuffler(&grid_, &random_);
+    shuffler.shuffle();
+    _updateMasks();     // Elements have been moved
 
-    // step 6 : rearrange block of lines
-    shuffler.shuffleRowBlocks();
-
-    // step 7 : all elements are "original"
-    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
-        elements_[index].setStatus(STATUS_ORIGINAL | STATUS_SET);
-    }
+    // step 3 : all elements are "original"
+    memset(grid_.status, STATUS_ORIGINAL | STATUS_SET, VALUES_COUNT);
 
 #ifndef DEST_CASIO_CALC
     display();
     cout << " <<<<<<< ";
 #endif // #ifndef DEST_CASIO_CALC
 
-    // step 8 : remove values according to expected complexity
+    // step 4 : remove values according to expected complexity
     uint8_t maxIndex = ROW_COUNT * LINE_COUNT;
     uint8_t clues(maxIndex);  // Starting with full grid
     bool stop(false);
     uint8_t val, blocked(true);
-    uint8_t index;
-    sudoku tester;
+    position index;
 
     while (!stop && clues > complexity){
-        //index.moveTo(rand() % LINE_COUNT, rand() % ROW_COUNT);
-        index = (rand() % maxIndex);
+        index = position(random_.below(maxIndex));
 
-        if (!(elements_[index] == 0)){
-            val = elements_[index].empty();
+        if (!(_element(index) == 0)){
+            val = _emptyValue(index);
 
             // Still a unique sol ?
-            tester.setElements(elements_);
-            if (1 == tester.multipleSolutions()){
+            if (!_hasOtherSolution(index, val) && !_exhausted()){
                 // Yes => continue
-                elements_[index].empty();
                 clues--;
             }
             else{
                 // return to previous stats
-                elements_[index].setValue(val, true);
+                _setValue(index, val, true);
 
                 // Try to many times => accept this solution
-                if (++blocked > COMPLEXITY_BLOCKED_MAX){
+                if (_exhausted() || ++blocked > COMPLEXITY_BLOCKED_MAX){
                     stop = true;
                 }
             }
@@ -920,60 +963,65 @@ uint8_t sudoku::_create(uint8_t complexity){
     return clues;
 }
 
+// _solve() : Find a solution for the current grid
 //
-// Checks
-//
-
-// _checkLine() : Can we put the value at the current line ?
-//
-//  @pos : position
-//  @value : Check this value at this position's line
+//  No UI is used
 //
-//  @return : true if the given value is valid in the given line
+//  @return : true if a solution was found
 //
-bool sudoku::_checkLine(position& pos, uint8_t value){
-    uint8_t idFirst(pos.line() * ROW_COUNT);
-    for (uint row = 0; row < ROW_COUNT; row++){
-        if (elements_[idFirst + row].value() == value){
-            return false;   // The value is already in the line
+bool sudoku::_solve(){
+    uint8_t values[VALUES_COUNT];
+    _copyValues(values);
+
+    solverEngine* engine(_engine());
+    bool found(engine->solve(values));
+    nodes_ = engine->nodes();
+    if (found){
+        // Copy the found values
+        for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+            if (EMPTY_VALUE == grid_.values[index]){
+                _setValue(index, values[index]);
+            }
         }
     }
 
-    // yes !!!
-    return true;
+    return found;
 }
 
-// _checkRow() : Can we put the value at the current row ?
+// _hasOtherSolution() : Does a grid with a single solution get
+//              another one once a value has been removed ?
 //
-//  @pos : position
-//  @value : Check this value at this position's row
+//  A new solution can only have another value at the emptied
+//  position : each other candidate is tried with a search for a
+//  single solution, which stops much sooner than counting solutions
+//
+//  @index : index of the emptied position
+//  @value : value removed
 //
-//  @return : true if the given value is valid in the given row
+//  @return : true if another solution exists
 //
-bool sudoku::_checkRow(position& pos, uint8_t value){
-    uint8_t idFirst(pos.row());
-    for (uint line = 0; line < LINE_COUNT; line++){
-        if (elements_[line * ROW_COUNT + idFirst].value() == value){
-            return false;  // The value is already in the row
+bool sudoku::_hasOtherSolution(uint8_t index, uint8_t value){
+    solverEngine* engine(_engine());
+    uint8_t values[VALUES_COUNT];
+    uint16_t others(_candidates(index) & ~VALUE_BIT(value));
+    for (uint8_t other(VALUE_MIN); others && !engine->exhausted(); other++){
+        if (others & VALUE_BIT(other)){
+            others &= ~VALUE_BIT(other);
+
+            _copyValues(values);
+            values[index] = other;
+            if (engine->solve(values)){
+                return true;
+            }
         }
     }
 
-    // yes
-    return true;
+    return false;
 }
 
-// _checkValue() : Can we put the value at the current position ?
 //
-//  @pos : position
-//  @value : Check the given value at this 'position'
-//
-//  @return : true if the given value is valid at the given position
+// Checks
 //
-bool sudoku::_checkValue(position& pos, uint8_t value){
-    return (_checkLine(pos, value) &&
-            _checkRow(pos, value) &&
-            _checkTinySquare(pos, value));
-}
 
 // _checkAndSet() : Try to put the value at the given position
 //
@@ -985,7 +1033,7 @@ bool sudoku::_checkValue(position& pos, uint8_t value){
 //          1 if new value set
 //
 int sudoku::_checkAndSet(position& pos, uint8_t value, uint8_t mode){
-    uint8_t status(elements_[pos].status());
+    uint8_t status(_element(pos).status());
     bool editGrid(true);
     if (EDIT_MODE_MANUAL == mode){
         // Check wether element's value can be changed
@@ -996,18 +1044,17 @@ int sudoku::_checkAndSet(position& pos, uint8_t value, uint8_t mode){
         editGrid = false;   // manual mode
     }
 
-    uint8_t oValue(elements_[pos].value());  // current val
+    uint8_t oValue(_element(pos).value());  // current val
 
     // Check value at the given pos.
     //  New allowed value or same value with different hyp. colour
     int hypColour(_hypColour(hypID_));
-    if ((oValue == value && elements_[pos.index()].hypColour() != hypColour)
+    if ((oValue == value && _element(pos.index()).hypColour() != hypColour)
         ||
-        (_checkLine(pos, value) && _checkRow(pos, value) &&
-        _checkTinySquare(pos, value))){
+        _checkValue(pos, value)){
         // Set new value and colour
-        elements_[pos.index()].setValue(value, editGrid);
-        elements_[pos.index()].setHypColour(hypColour);
+        _setValue(pos, value, editGrid);
+        _element(pos.index()).setHypColour(hypColour);
 
         // First value with this hyp ?
         if (-1 == hypotheses_[hypID_].firstPos){
@@ -1023,8 +1070,7 @@ int sudoku::_checkAndSet(position& pos, uint8_t value, uint8_t mode){
 // _onEditCheckSudoku() : Check wether grid can be solved
 //
 void sudoku::_onEditCheckSudoku(){
-    sudoku tester(*this);
-    int count = tester.multipleSolutions(); // try to find solution(s)
+    uint8_t count(countSolutions(2));   // try to find solution(s)
 
 #ifdef DEST_CASIO_CALC
     window output;
@@ -1038,7 +1084,7 @@ void sudoku::_onEditCheckSudoku(){
     output.create(wInf);
 
     switch (count){
-        case -1:
+        case 2:
             output.drawText(STR_MULTIPLE_SOL, -1, -1, COLOUR_RED);
             break;
 
@@ -1119,16 +1165,15 @@ void sudoku::_drawBackground(){
 //
 void sudoku::_drawContent(){
     position pos(0, false);
-    element* pElement(NULL);
     uint8_t line, row;
     for (line = 0; line < LINE_COUNT; line++){
         for (row = 0; row < ROW_COUNT; row++){
-            pElement = &elements_[pos];
-            if (!pElement->isEmpty()){
+            element current(_element(pos));
+            if (!current.isEmpty()){
                 _drawSingleElement(pos,
                     (pos.squareID()%2)?GRID_BK_COLOUR_DARK:GRID_BK_COLOUR,
-                    (pElement->isOriginal()?TXT_ORIGINAL_COLOUR:
-                    (pElement->isObvious()?TXT_OBVIOUS_COLOUR:TXT_COLOUR))
+                    (current.isOriginal()?TXT_ORIGINAL_COLOUR:
+                    (current.isObvious()?TXT_OBVIOUS_COLOUR:TXT_COLOUR))
                     );
             }
             pos++; // next element
@@ -1145,9 +1190,9 @@ void sudoku::_drawContent(){
 //
 void sudoku::_drawSingleElement(position pos, int bkColour, int txtColour){
 #ifdef DEST_CASIO_CALC
-    element* pElement(&elements_[pos]);
-    uint8_t row(pos.row()), line(pos.line()), value(pElement->value());
-    int hypColour(pElement->hypColour());
+    element current(_element(pos));
+    uint8_t row(pos.row()), line(pos.line()), value(current.value());
+    int hypColour(current.hypColour());
     uint16_t x(screen_.x + row * SQUARE_SIZE + BORDER_THICK);
     uint16_t y(screen_.y + line * SQUARE_SIZE + BORDER_THICK);
 
@@ -1212,337 +1257,10 @@ void sudoku::_drawHypotheses(){
 //   Search for obvious values
 //
 
-// _findObviousValues() :
-//  Search and set all the possible obvious values in the grid
-//
-//  @return the # of values found (and set)
-//
-uint8_t sudoku::_findObviousValues(){
-    uint8_t found(0);
-    position pos(0, true);
-    int8_t value;
-
-    for (uint8_t index = 0; index <= INDEX_MAX; index++){
-        if (elements_[pos].isEmpty()){
-            // Try to set a single value at this empty place
-            if ((value = _checkObviousValue(pos))){
-                // One more obvious value !!!!
-                elements_[pos].setValue(value, STATUS_OBVIOUS);
-                found++;
-            }
-        }
-        else{
-            value = elements_[pos].value();    // Current "ORIGINAL" val.
-
-            // Can we put this value on another line ?
-            found += _setObviousValueInLines(pos, value);
-
-            // ... or/and put it in another row ?
-            found += _setObviousValueInRows(pos, value);
-        }
-
-        // Next pos.
-        pos++;
-
-    }   // for
-
-    return found;
-}
-
-// _checkObviousValue() : Is there an obvious value for the given pos ?
-//
-//  pos : current position in the grid
-//
-//  @returns the value or 0
-//
-uint8_t sudoku::_checkObviousValue(position& pos){
-    uint8_t value(0);
-
-    for (uint8_t candidate = VALUE_MIN; candidate <= VALUE_MAX; candidate++){
-        if (_checkValue(pos, candidate)){
-            // This candidate value can be used
-            if (value){
-                // already a possible value at this pos.
-                // => no unique value can be guessed
-                return 0;
-            }
-            value = candidate;
-        }
-    }
-
-    return value;
-}
-
-// _setObviousValueInLines() : Try to put the value in another line
-//
-//  @pos : start position
-//  @value : value to "put"
-//
-//  @return : count (0 or 1) of value set
-//
-uint8_t sudoku::_setObviousValueInLines(position& pos, uint8_t value){
-
-    // Check for lines in the 3 tinySquares
-    //
-
-    // tinySquares IDs for this line
-    uint8_t modID(pos.squareID() % 3);
-    uint8_t firstID, secondID;
-    if (0 ==  modID){
-        // At the left pos
-        firstID = pos.squareID() + 1;
-        secondID = pos.squareID() + 2;
-    }
-    else{
-        if (1 == modID){
-            // centered
-            firstID = pos.squareID() - 1;
-            secondID = pos.squareID() + 1;
-        }
-        else{
-            // on the right
-            firstID = pos.squareID() - 2;
-            secondID = pos.squareID() - 1;
-        }
-    }
-
-    // Is the value already in theses tiny squares ?
-    CPOINT firstPos(tSquares_[firstID].findValue(elements_, value));
-    CPOINT secondPos(tSquares_[secondID].findValue(elements_, value));
-
-    // No for both of them or yes for both
-    if ((-1 == firstPos.line && -1 == secondPos.line)
-            || (-1 != firstPos.line && -1 != secondPos.line)){
-        return 0;
-    }
-
-    // Just one square misses the value => we'll try to put
-    // this value in the correct line
-    //
-    uint8_t candidate, candidateLine;
-    if (-1 == firstPos.line){
-        candidate = firstID;
-        candidateLine = 2 * (tSquares_[firstID].topLine() + 1)
-                        - secondPos.line - pos.line() + 1;
-    }
-    else{
-        candidate = secondID;
-        candidateLine = 2 * (tSquares_[secondID].topLine() + 1)
-                        - firstPos.line - pos.line() + 1;
-    }
-
-    // Try to put the value in the line
-    //
-    bool found(false);
-    position candidatePos(0, true), foundPos;
-    candidatePos.moveTo(candidateLine,
-                        tSquares_[candidate].topRow());   // First row ID
-
-    for (uint8_t row = 0; row < TINY_ROW_COUNT; row++){
-        if (elements_[candidatePos].isEmpty() &&
-            _checkValue(candidatePos, value)){
-            // found a valid pos. in the line for the value
-            if (found){
-                // Already a candiate
-                return 0;
-            }
-
-            foundPos.set(candidatePos);
-            found = true;
-        }
-
-        // Next row
-        candidatePos++;
-    }
-
-    // Did we find a position ?
-    if (found){
-        // Yes => one more obvious val.
-        elements_[foundPos].setValue(value, STATUS_OBVIOUS);
-        return 1;
-    }
-
-    // No ...
-    return 0;
-}
-
-// _setObviousValueInRows() : Try to put the value in another row
-//
-//  @pos : start position
-//  @value : value to "put"
-//
-//  @return : count (0 or 1) of value set
-//
-uint8_t sudoku::_setObviousValueInRows(position& pos, uint8_t value){
-
-    // Check for lines in the 3 tinySquares
-    //
-
-    // tinySquares IDs for this line
-    uint8_t modID(floor(pos.squareID() / 3));
-    uint8_t firstID, secondID;
-    if (0 ==  modID){
-        // At the top pos
-        firstID = pos.squareID() + TINY_ROW_COUNT;
-        secondID = pos.squareID() + 2 * TINY_ROW_COUNT;
-    }
-    else{
-        if (1 == modID){
-            // centered
-            firstID = pos.squareID() - TINY_ROW_COUNT;
-            secondID = pos.squareID() + TINY_ROW_COUNT;
-        }
-        else{
-            // on the bottom
-            firstID = pos.squareID() - 2 * TINY_ROW_COUNT;
-            secondID = pos.squareID() - 1 * TINY_ROW_COUNT;
-        }
-    }
-
-    // Is the value already in theses tiny squares ?
-    CPOINT firstPos(tSquares_[firstID].findValue(elements_, value));
-    CPOINT secondPos(tSquares_[secondID].findValue(elements_, value));
-
-    // No for both of them or yes for both
-    if ((-1 == firstPos.row && -1 == secondPos.row)
-        || (-1 != firstPos.row && -1 != secondPos.row)){
-        return 0;
-    }
-
-    // Just one square misses the value
-    // => we'll try to put this value in the correct line
-    //
-    uint8_t candidate, candidateRow;
-    if (firstPos.row == -1){
-        candidate = firstID;
-        candidateRow = 2 * (tSquares_[firstID].topRow() + 1)
-                    - secondPos.row - pos.row() + 1;
-    }
-    else{
-        candidate = secondID;
-        candidateRow = 2 * (tSquares_[secondID].topRow() + 1)
-                    - firstPos.row - pos.row() + 1;
-    }
-
-    // Try to put the value ...
-    //
-    bool found(false);
-    position candidatePos(0, true), foundPos;
-    candidatePos.moveTo(tSquares_[candidate].topLine(), candidateRow);
-
-    for (uint8_t line = 0; line < TINY_LINE_COUNT; line++){
-            if  (elements_[candidatePos].isEmpty()
-                    && _checkValue(candidatePos, value)){
-                if (found){
-                    // Already a candiate
-                    return 0;
-                }
-
-                foundPos.set(candidatePos);
-                found = true;
-            }
-
-            // Next line
-            candidatePos += ROW_COUNT;
-    }
-
-    // Did we find a valid position ?
-    if (found){
-        // Yes !!!
-        elements_[foundPos].setValue(value, STATUS_OBVIOUS);
-        return 1;
-    }
-
-    // No ...
-    return 0;
-}
-
-//
-// Resolving
-//
-
-// _resolve() : Find a solution for the current grid
-//
-//  The algorithm will go forward to seek value and backward each
-//  time a value can't be found at a given pos.
-//  We going backward, if position reaches sPos (if not NULL)
-//  or exit the grid, the method end with no solution.
-//
-//  @sPos : Start position. If NULL the method will start
-//          from the first empty pos found in the grid
-//
-//  @return : true if a solution was found
-//
-bool sudoku::_resolve(position* sPos){
-    uint8_t candidate;
-    position pos(0, true);
-    uint8_t startIndex;
-    uint8_t status;
-
-    if (NULL == sPos){
-      status = _findFirstEmptyPos(pos);  // Start from beginning
-      startIndex = 0;
-      candidate = 0;
-    }
-    else{
-        pos = *sPos;    // Use given pos as start index
-        startIndex = pos;
-        status = pos.status();
-        candidate = elements_[pos].value() - 1; // ++ in the loop !
-        elements_[pos].setValue(0);
-    }
-
-    // All the elements "before" the current position - pos -
-    // are set with possible/allowed values
-    // we'll try to put the "candidate" value
-    // (ie. the smallest possible value) at the current position
-    while (POS_VALID == status){
-        candidate++;   // Next possible value
-
-        if (candidate > VALUE_MAX){
-            // No possible value found at this position
-            // we'll have to go backward, to the last value setted
-            // when no position can be found (ie. all possibles values
-            // have  been previously tested), the next pos has an
-            // invalid index, -1, and status = POS_INDEX_ERROR
-            // no soluton can be found
-            if (POS_VALID == (status = _previousPos(pos))){
-                if (pos >= startIndex){
-                    // next candidate value is the currently used value + 1
-                    candidate = elements_[pos].empty();
-                }
-                else{
-                    // return to start pos => no soluce
-                    status = POS_INDEX_ERROR;
-                }
-            }
-        }
-        else{
-            // Try to put the "candidate" value at current position
-            //
-            if (_checkValue(pos, candidate)){
-                // Possible => put this candidate value
-                elements_[pos].setValue(candidate);
-
-                // Go to the next "empty" position
-                // if the grid is completed, the next pos is
-                // out of range ! (status = POS_END_OF_LIST)
-                status = _findFirstEmptyPos(pos);
-
-                // At the next pos.,
-                // we'll use (again) the lowest possible value
-                candidate = 0;
-            }
-        }
-    } // while (!status)
-
-    // No solution
-    return (POS_END_OF_LIST == status);
-}
-
 // _onManualHelp() : Help the user to solve the current grid
 //
-//  A new clue element is shown
+//  A new clue element is shown. It is chosen among the free elements
+//  with the fewest candidates : the easiest ones to find
 //
 //  @menu : Edit sub-menu
 //
@@ -1556,8 +1274,6 @@ int8_t sudoku::_onManualHelp(menuBar& menu){
 
     // No sol. in memory ?
     if (NULL == soluce_){
-        srand((unsigned int)clock());   // Set root
-
         sudoku solver(*this);
         if (!solver.resolve(NULL, &soluce_)){
             // Unable to find a solution (???)
@@ -1566,30 +1282,42 @@ int8_t sudoku::_onManualHelp(menuBar& menu){
     }
 
     // # of free items
-    uint8_t freeItems(ROW_COUNT * LINE_COUNT);
+    uint8_t freeItems(VALUES_COUNT - valuesCount_);
     int8_t index;
-    for (index = INDEX_MIN; index < INDEX_MIN; index++){
-        if (elements_[index].isEmpty()){
-            freeItems--;
-        }
-    }
 
     if (freeItems <= MIN_CLUE_COUNT){
         return -1; // No need to help the use, the grid is nearly full
     }
 
-    // Randomly select an item in the free ones
-    uint8_t clueID(1 + (rand() % freeItems));
+    // Free items with the fewest candidates
+    uint8_t count, minCount(VALUE_MAX + 1);
+    for (index = INDEX_MIN; index <= INDEX_MAX; index++){
+        if (EMPTY_VALUE == grid_.values[index]){
+            if ((count = __builtin_popcount(candidates(index))) < minCount){
+                minCount = count;
+                freeItems = 0;
+            }
+
+            if (count == minCount){
+                freeItems++;
+            }
+        }
+    }
+
+    // Randomly select one of them
+    uint8_t clueID(1 + random_.below(freeItems));
     index = -1;
     while (clueID){
-        if (elements_[++index].isEmpty()){
+        if (EMPTY_VALUE == grid_.values[++index]
+            && minCount == __builtin_popcount(candidates(index))){
             clueID--;
         }
     }
 
     // Found one !
     int8_t helpValue(soluce_[index] * -1);  // found value is < 0
-    elements_[index].setValue(helpValue, true);
+    position helpPos(index);
+    _setValue(helpPos, helpValue, true);
     display();
 
     if (!(--helpClues_)){
@@ -1599,45 +1327,6 @@ int8_t sudoku::_onManualHelp(menuBar& menu){
     return index;
 }
 
-// _findFirstEmptyPos() : Find the first empty pos.
-//
-//  @start : position where to start the search
-//
-//  @return : status of position (POS_VALID or POS_END_OF_LIST)
-//
-uint8_t sudoku::_findFirstEmptyPos(position &start){
-    while (POS_END_OF_LIST != start.status() && !elements_[start].isEmpty()){
-        start += 1; // next element
-    }
-
-    // Done ?
-    return start.status();
-}
-
-// _previousPos() : Returns to the previous position
-//
-//  Go backward in the grid to find a valid position.
-//  If position index is -1, the method will return POS_INDEX_ERROR
-//  ie. no solution for this grid
-//
-//  @current : current position
-//
-//  @return the status of the position (POS_VALID or POS_INDEX_ERROR)
-//
-uint8_t sudoku::_previousPos(position& current){
-    // Clear value at current post
-    elements_[current].empty();
-
-    // Don't touch "Original" nor "Obvious" values
-    current--;
-    while (POS_VALID == current.status()
-            && !elements_[current].isChangeable()){
-        current--;
-    }
-
-    return current.status();
-}
-
 #ifdef DEST_CASIO_CALC
 // __callbackTick() : Call back function for timer
 // This function is used during edition to make selected item blink
@@ -1727,11 +1416,11 @@ int sudoku::_elementTxtColour(position& pos, uint8_t editMode, bool selected){
         return (TXT_ORIGINAL_COLOUR);   // always use "original" colour
     }
 
-    if (elements_[pos].isObvious()){
+    if (_element(pos).isObvious()){
         return TXT_OBVIOUS_COLOUR;
     }
     else{
-        if (elements_[pos].isOriginal()){
+        if (_element(pos).isOriginal()){
             return TXT_ORIGINAL_COLOUR;
         }
         else{
@@ -1828,8 +1517,8 @@ uint8_t sudoku::_hypAccept(int colFrom, int colTo){
     uint8_t count(0);
     if (colFrom != colTo){
         for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
-            if (colFrom == elements_[index].hypColour()){
-                elements_[index].setHypColour(colTo);
+            if (colFrom == _element(index).hypColour()){
+                _element(index).setHypColour(colTo);
                 count++;
             }
         }
@@ -1851,11 +1540,15 @@ uint8_t sudoku::_hypReject(int colFrom){
     uint8_t count(0);
     if (colFrom != HYP_NO_COLOUR){
         for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
-            if (colFrom == elements_[index].hypColour()){
-                elements_[index].empty();
+            if (colFrom == _element(index).hypColour()){
+                _element(index).empty();
                 count++;
             }
         }
+
+        if (count){
+            _updateMasks();
+        }
     }
 
     return count;
@@ -1990,6 +1683,80 @@ void sudoku::_newFileName(FONTCHARACTER fName){
     }
 }
 
+// _setValue() : Set or modify the value of an element
+//
+//  Values' masks are updated accordingly
+//
+//  @index : index of the element
+//  @value : new value
+//  @editMode : true if the grid is currently in edit mode
+//
+void sudoku::_setValue(uint8_t index, uint8_t value, bool editMode){
+    element current(_element(index));
+    uint8_t oValue(current.value());
+    current.setValue(value, editMode);
+    value = current.value();  // original values can't be changed
+
+    if (value != oValue){
+        if (!oValue){
+            valuesCount_++;
+        }
+        else if (!value){
+            valuesCount_--;
+        }
+
+        // Bits that changed
+        uint16_t bits((oValue?VALUE_BIT(oValue):0) ^
+                        (value?VALUE_BIT(value):0));
+        lineMasks_[gGridTables.line[index]] ^= bits;
+        rowMasks_[gGridTables.row[index]] ^= bits;
+        squareMasks_[gGridTables.square[index]] ^= bits;
+    }
+}
+
+// _emptyValue() : Empty an element
+//
+//  Values' masks are updated accordingly
+//
+//  @index : index of the element
+//
+//  @return : previous value
+//
+uint8_t sudoku::_emptyValue(uint8_t index){
+    uint8_t value(_element(index).empty());
+    if (value){
+        valuesCount_--;
+        uint16_t bit(~VALUE_BIT(value));
+        lineMasks_[gGridTables.line[index]] &= bit;
+        rowMasks_[gGridTables.row[index]] &= bit;
+        squareMasks_[gGridTables.square[index]] &= bit;
+    }
+
+    return value;
+}
+
+// _updateMasks() : Rebuild all the values' masks
+//
+//  Must be called when elements have been changed "outside"
+//  of _setValue() and _emptyValue()
+//
+void sudoku::_updateMasks(){
+    memset(lineMasks_, 0, sizeof(lineMasks_));
+    memset(rowMasks_, 0, sizeof(rowMasks_));
+    memset(squareMasks_, 0, sizeof(squareMasks_));
+    valuesCount_ = 0;
+
+    uint8_t value;
+    for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
+        if ((value = grid_.values[index])){
+            valuesCount_++;
+            lineMasks_[gGridTables.line[index]] |= VALUE_BIT(value);
+            rowMasks_[gGridTables.row[index]] |= VALUE_BIT(value);
+            squareMasks_[gGridTables.square[index]] |= VALUE_BIT(value);
+        }
+    }
+}
+
 // _revertFrom : Return to the original state
 //
 //  All values "after" @from prosition will be set to 0 if
@@ -1999,10 +1766,12 @@ void sudoku::_newFileName(FONTCHARACTER fName){
 //
 void sudoku::_revertFrom(uint8_t from){
     for (uint8_t index(from); index <= INDEX_MAX ; index++){
-        if (!elements_[index].isOriginal()){
-            elements_[index].empty();
+        if (!_element(index).isOriginal()){
+            _element(index).empty();
         }
     }
+
+    _updateMasks();
 }
 
 //  _copyElements() : Create a copy of current elements table
@@ -2015,11 +1784,19 @@ void sudoku::_revertFrom(uint8_t from){
 void sudoku::_copyElements(int8_t* dest){
     uint8_t value;
     for (uint8_t index(INDEX_MIN); index <= INDEX_MAX; index++){
-        value = elements_[index].value();
-        dest[index] = value * (elements_[index].isOriginal()?1:-1);
+        value = _element(index).value();
+        dest[index] = value * (_element(index).isOriginal()?1:-1);
     }
 }
 
+//  _copyValues() : Copy the values of all the elements
+//
+//  @dest : destination table (EMPTY_VALUE for empty elements)
+//
+void sudoku::_copyValues(uint8_t* dest){
+    memcpy(dest, grid_.values, VALUES_COUNT);
+}
+
 //  _freeSoluce() : Free the memory allocated for a solution
 //
 void sudoku::_freeSoluce(void){
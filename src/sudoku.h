@@ -16,6 +16,10 @@
 #include "element.h"
 #include "position.h"
 #include "tinySquare.h"
+#include "solverEngine.h"
+#include "humanSolver.h"
+#include "randomGenerator.h"
+#include "gridTables.h"
 
 #include "shared/bFile.h"
 
@@ -49,10 +53,15 @@ enum GRID_COMPLEXITTY{
 
 #define COMPLEXITY_BLOCKED_MAX  4
 
+// Max. # of grids generated by create()
+#define CREATE_ATTEMPTS_MAX     16
+
 #ifdef __cplusplus
 extern "C" {
 #endif // #ifdef __cplusplus
 
+class sudokuSolutions;
+
 //   sudoku : Edition and/or resolution of a single sudoku grid
 //
 class sudoku{
@@ -69,9 +78,17 @@ public:
 
     // setElments() : set elements of the grid
     //
-    //  @elements : list of elements
+    //  @grid : values, status and hyp. of the elements
+    //
+    void setElements(const GRID* grid);
+
+    // getElements() : get elements of the grid
+    //
+    //  @grid : will receive values, status and hyp. of the elements
     //
-    void setElements(element* elements);
+    void getElements(GRID* grid){
+        memcpy(grid, &grid_, sizeof(GRID));
+    }
 
     // setScreenRect() : Screen dimensions
     //
@@ -102,6 +119,19 @@ public:
     // pause() : Show pause screen
     //
     static void pause();
+
+    // setSeed() : Seed of the next grids created
+    //
+    //  Grids created after the same seed are always the same. The
+    //  grid #@index of a batch gets its own seed : it can be generated
+    //  alone or in any order
+    //
+    //  @seed : seed (of the batch)
+    //  @index : index of the grid in the batch
+    //
+    void setSeed(uint32_t seed, uint32_t index = 0){
+        random_.setSeed(randomGenerator::seedOf(seed, index));
+    }
 
     // create() : Create a new sudoku
     //
@@ -111,6 +141,18 @@ public:
     //
     int create(uint8_t complexity);
 
+    // create() : Create a new sudoku with limited searches
+    //
+    //  When the budget is exhausted, the grid may be incomplete.
+    //  The budget is only used during the call
+    //
+    //  @complexity : Complexity level in {}
+    //  @budget : limits and statistics of all the searches
+    //
+    //  @return : # of clues, -1 on error or SEARCH_EXHAUSTED
+    //
+    int create(uint8_t complexity, SEARCH_BUDGET& budget);
+
     //
     // io
     //
@@ -129,6 +171,23 @@ public:
     //
     uint8_t load(const FONTCHARACTER fName);
 
+    // readValues() : Read the values of a grid file
+    //
+    //  Values are not checked
+    //
+    //  @fName : file to read
+    //  @values : will receive the values
+    //
+    //  @return : 0 on success or an error code
+    //
+    static uint8_t readValues(const FONTCHARACTER fName, uint8_t* values);
+
+    // originalValues() : Get the "original" values of the grid
+    //
+    //  @values : will receive the values (EMPTY_VALUE if not original)
+    //
+    void originalValues(uint8_t* values);
+
    // save() : Save the grid on a file
     //
     //  In the given grid, only "original" values
@@ -159,10 +218,7 @@ public:
 
     // resolve() : Find a solution for the current grid
     //
-    //  The algorithm will go forward to seek value and backward each
-    //  time a value can't be found at a given pos.
-    //  When going backward, if position reaches sPos (if not NULL)
-    //  or exits the grid, the method ends with no solution.
+    //  The search is done by the engine selected with setSearchMode()
     //
     //  @mDuration : points to an int that will receive duration
     //              of solving process in ms. Can be NULL
@@ -173,6 +229,113 @@ public:
     //
     bool resolve(int* mDuration = NULL, int8_t** soluce = NULL);
 
+    // resolve() : Find a solution for the current grid with a limited search
+    //
+    //  @budget : limits and statistics of the search
+    //
+    //  @return : 1 if a solution was found, 0 if the grid has no solution
+    //          or SEARCH_EXHAUSTED if the search has been stopped
+    //
+    int8_t resolve(SEARCH_BUDGET& budget);
+
+    // setSearchMode() : Choose the solver engine used by resolve(),
+    //                  countSolutions() and findObviousValues()
+    //
+    //  @mode : ID of a registered engine : SEARCH_MODE_LINEAR,
+    //          SEARCH_MODE_MRV, SEARCH_MODE_DLX or SEARCH_MODE_PROPAGATE
+    //
+    void setSearchMode(uint8_t mode){
+        if (mode < SEARCH_MODE_COUNT){
+            searchMode_ = mode;
+        }
+    }
+
+    // setSearchEngine() : Choose the solver engine by its name
+    //
+    //  @name : name of a registered engine
+    //
+    //  @return : false if no engine has this name
+    //
+    bool setSearchEngine(const char* name){
+        int8_t id(solverEngine::find(name));
+        setSearchMode((uint8_t)id);
+        return (id >= 0);
+    }
+
+    // grade() : Rating of the grid
+    //
+    //  The grid is solved with the techniques of human players,
+    //  from the cheapest to the most expensive
+    //
+    //  @hardest : points to an int8_t that will receive the ID
+    //          of the most expensive technique used. Can be NULL
+    //
+    //  @return : rating (x 10), GRADE_NONE, GRADE_SEARCH if the grid
+    //          can't be completed with these techniques or GRADE_INVALID
+    //
+    int8_t grade(int8_t* hardest = NULL);
+
+    // valuesCount() : # of values in the grid
+    //
+    //  The count is kept up to date on each change
+    //
+    //  @return : # of non-empty elements
+    //
+    uint8_t valuesCount(){
+        return valuesCount_;
+    }
+
+    // candidates() : Values that can still be put at a position
+    //
+    //  @index : index of the position
+    //
+    //  @return : bit mask of the candidates (0 if not empty)
+    //
+    uint16_t candidates(uint8_t index){
+        return (grid_.values[index]?0:_candidates(index));
+    }
+
+    // nodes() : # of values tried during the last resolution
+    //
+    //  In SEARCH_MODE_PROPAGATE, only guessed values are counted
+    //
+    //  @return : count of "search nodes"
+    //
+    uint32_t nodes(){
+        return nodes_;
+    }
+
+    // countSolutions() : Count the solutions of the grid
+    //
+    //  The search is done in a single pass and stops as soon as @limit
+    //  solutions have been found. The grid is left unchanged.
+    //
+    //  @limit : max. # of solutions to search for
+    //
+    //  @return : # of solutions found (at most @limit)
+    //
+    uint8_t countSolutions(uint8_t limit);
+
+    // countSolutions() : Count the solutions of the grid with a limited
+    //                  search
+    //
+    //  @limit : max. # of solutions to search for
+    //  @budget : limits and statistics of the search. On exhaustion,
+    //          budget.solutions is the # of solutions already found
+    //
+    //  @return : # of solutions found (at most @limit) or SEARCH_EXHAUSTED
+    //
+    int8_t countSolutions(uint8_t limit, SEARCH_BUDGET& budget);
+
+    // solutions() : Enumerate the solutions of the grid
+    //
+    //  The solutions are searched one at a time, with no allocation,
+    //  and the enumeration can be stopped at any time
+    //
+    //  @return : an object that searches for the solutions
+    //
+    sudokuSolutions solutions();
+
     // multipleSolutions() : Check wether a grid has one or many solutions
     //
     //  This method doesn't seek for all possible solutions since it stops
@@ -183,19 +346,6 @@ public:
     //
     int multipleSolutions();
 
-    // findNextStartPos() : Find the next "starting" postion
-    //
-    //  This enables to search for another solution or check wether
-    //  a found solution is unique or not
-    //
-    //  @start : Position to search from
-    //          @start will point to the new position has been found
-    //  @startVal : New starting value
-    //
-    //  @return : true if a valid position has been found
-    //
-    bool findNextStartPos(position &start, int8_t& currentVal);
-
 private:
 
     // _create() : Create a new sudoku
@@ -206,46 +356,93 @@ private:
     //
     uint8_t _create(uint8_t complexity);
 
+    // _solve() : Find a solution for the current grid
     //
-    // Checks
+    //  No UI is used
     //
+    //  @return : true if a solution was found
+    //
+    bool _solve();
 
-    // _checkValue() : Can we put the value at the given position ?
+    // _hasOtherSolution() : Does a grid with a single solution get
+    //              another one once a value has been removed ?
     //
-    //  @pos : position
-    //  @value : Check the given value at this 'position'
+    //  @index : index of the emptied position
+    //  @value : value removed
     //
-    //  @return : true if the given value is valid at the given position
+    //  @return : true if another solution exists
     //
-    bool _checkValue(position& pos, uint8_t value);
+    bool _hasOtherSolution(uint8_t index, uint8_t value);
 
-    // _checkLine() : Can we put the value at the current line ?
+    // _exhausted() : Has the last search been stopped ?
     //
-    //  @pos : position
-    //  @value : Check this value at this position's line
+    //  @return : true if the budget of the current search is exhausted
+    //
+    bool _exhausted(){
+        return (budget_ && budget_->exhausted);
+    }
+
+    // _engine() : Engine of the current search mode
+    //
+    //  Engines are shared by all the sudoku objects : the budget of
+    //  this object is set before each use
     //
-    //  @return : true if the given value is valid in the given line
+    //  @return : pointer to the engine
     //
-    bool _checkLine(position& pos, uint8_t value);
+    solverEngine* _engine(){
+        solverEngine* engine(solverEngine::engine(searchMode_));
+        engine->setBudget(budget_);
+        return engine;
+    }
 
-    // _checkRow() : Can we put the value at the current row ?
+    // _setBudget() : Set the limits of the searches of this object
     //
-    //  @pos : position
-    //  @value : Check this value at this position's row
+    //  A budget is set at the start of a limited call and reset
+    //  (NULL) before it returns
     //
-    //  @return : true if the given value is valid in the given row
+    //  @budget : limits and statistics of the searches or NULL
     //
-    bool _checkRow(position& pos, uint8_t value);
+    void _setBudget(SEARCH_BUDGET* budget){
+        budget_ = budget;
+        solverEngine::engine(searchMode_)->setBudget(budget);
+    }
 
-    // _checTinySquare() : Can we put the value in this tinySquare ?
     //
-    //  @pos : position
-    //  @value : Check this value
+    // Checks
+    //
+
+    // _checkValue() : Can we put the value at the given position ?
+    //
+    //  @index : index of the position
+    //  @value : Check the given value at this 'position'
+    //
+    //  @return : true if the given value is valid at the given position
+    //
+    bool _checkValue(uint8_t index, uint8_t value){
+        return (0 == (_usedValues(index) & VALUE_BIT(value)));
+    }
+
+    // _usedValues() : Values already used in the line, the row and
+    //                 the tinySquare of a position
     //
-    //  @return : true if the given value is valid in the tinySquare
+    //  @index : index of the position
     //
-    bool _checkTinySquare(position& pos, uint8_t value){
-        return (false == tSquares_[pos.squareID()].inMe(elements_, value));
+    //  @return : mask of used values
+    //
+    uint16_t _usedValues(uint8_t index){
+        return (lineMasks_[gGridTables.line[index]]
+                | rowMasks_[gGridTables.row[index]]
+                | squareMasks_[gGridTables.square[index]]);
+    }
+
+    // _candidates() : Values that can be put at a position
+    //
+    //  @index : index of the position
+    //
+    //  @return : mask of allowed values
+    //
+    uint16_t _candidates(uint8_t index){
+        return (ALL_VALUES_MASK & ~_usedValues(index));
     }
 
     // _checkAndSet() : Try to  put the value at the given position
@@ -284,58 +481,6 @@ private:
     //
     void _drawHypotheses();
 
-    //
-    //   Search for obvious values
-    //
-
-    // _resolve() : Find a solution for the current grid
-    //
-    //  The algorithm will go forward to seek value and backward each
-    //  time a value can't be found at a given pos.
-    //  We going backward, if position reaches sPos (if not NULL)
-    //  or exit the grid, the method end with no solution.
-    //
-    //  @sPos : Start position. If NULL the method will start
-    //          from the first empty pos found in the grid
-    //
-    //  @return : true if a solution was found
-    //
-    bool _resolve(position* sPos);
-
-    // _findObviousValues() :
-    //  Search and set all the possible obvious values in the grid
-    //
-    //  @return the # of values found (and set)
-    //
-    uint8_t _findObviousValues();
-
-    // _checkObviousValue() : Is there an obvious value
-    //  for the given position ?
-    //
-    //  pos : current position in the grid
-    //
-    //  @returns the value or 0
-    //
-    uint8_t _checkObviousValue(position& pos);
-
-    // _setObviousValueInLines() : Try to put the value in another line
-    //
-    //  @pos : start position
-    //  @value : value to "put"
-    //
-    //  @return : count (0 or 1) of value set
-    //
-    uint8_t _setObviousValueInLines(position& pos, uint8_t value);
-
-    // _setObviousValueInRows() : Try to put the value in another row
-    //
-    //  @pos : start position
-    //  @value : value to "put"
-    //
-    //  @return : count (0 or 1) of value set
-    //
-    uint8_t _setObviousValueInRows(position& pos, uint8_t value);
-
     // _onEditCheckSudoku() : Check wether grid can be solved
     //
     void _onEditCheckSudoku();
@@ -354,26 +499,6 @@ private:
     //
     int8_t _onManualHelp(menuBar& menu);
 
-    // _findFirstEmptyPos() : Find the first empty pos.
-    //
-    //  @start : position where to start the search
-    //
-    //  @return : status of position (POS_VALID or POS_END_OF_LIST)
-    //
-    uint8_t _findFirstEmptyPos(position &start);
-
-    // _previousPos() : Returns to the previous position
-    //
-    //  Go backward in the grid to find a valid position.
-    //  If position index is -1, the method will return POS_INDEX_ERROR
-    //  ie. no solution for this grid
-    //
-    //  @current : current position
-    //
-    //  @return the status of the position (POS_VALID or POS_INDEX_ERROR)
-    //
-    uint8_t _previousPos(position& current);
-
 #ifdef DEST_CASIO_CALC
     // __callbackTick() : Call back function for timer
     // This function is used during edition to make selected item blink
@@ -507,6 +632,33 @@ private:
     //
     void _newFileName(FONTCHARACTER fName);
 
+    // _setValue() : Set or modify the value of an element
+    //
+    //  Values' masks are updated accordingly
+    //
+    //  @index : index of the element
+    //  @value : new value
+    //  @editMode : true if the grid is currently in edit mode
+    //
+    void _setValue(uint8_t index, uint8_t value, bool editMode = false);
+
+    // _emptyValue() : Empty an element
+    //
+    //  Values' masks are updated accordingly
+    //
+    //  @index : index of the element
+    //
+    //  @return : previous value
+    //
+    uint8_t _emptyValue(uint8_t index);
+
+    // _updateMasks() : Rebuild all the values' masks
+    //
+    //  Must be called when elements have been changed "outside"
+    //  of _setValue() and _emptyValue()
+    //
+    void _updateMasks();
+
     // _revertFrom : Return to the "original" state
     //
     //  All values "after" @from prosition will be set to 0 if
@@ -525,6 +677,12 @@ private:
     //
     void _copyElements(int8_t* dest);
 
+    //  _copyValues() : Copy the values of all the elements
+    //
+    //  @dest : destination table (EMPTY_VALUE for empty elements)
+    //
+    void _copyValues(uint8_t* dest);
+
     //  _freeSoluce() : Free the memory allocated for a solution
     //
     void _freeSoluce(void);
@@ -534,10 +692,27 @@ private:
         return (hypID < 0? HYP_NO_COLOUR:hypotheses_[hypID].colour);
     }
 
+    // _element() : Access to an element of the grid
+    //
+    //  @index : index of the element
+    //
+    //  @return : the element
+    //
+    element _element(uint8_t index){
+        return element(&grid_, index);
+    }
+
     // Members
 private:
-    element elements_[LINE_COUNT * ROW_COUNT];
+    GRID grid_;                         // Elements of the grid
     tinySquare tSquares_[TINY_COUNT];   // Access to elements in tinySquares
+
+    // Values used in each line, row and tinySquare
+    uint16_t lineMasks_[LINE_COUNT];
+    uint16_t rowMasks_[ROW_COUNT];
+    uint16_t squareMasks_[TINY_COUNT];
+    uint8_t valuesCount_;               // # of non-empty elements
+
     int8_t *soluce_;   // A solution for the current grid
 
     char sFileName_[BFILE_MAX_PATH + 1];    // current short filename
@@ -558,6 +733,12 @@ private:
     int8_t hypID_;                      // Current hyp. index
 
     uint8_t helpClues_;                 // # of possible help clues left
+
+    // Resolution
+    randomGenerator random_;            // Used to create grids
+    uint8_t searchMode_;
+    uint32_t nodes_;                    // # of values tried
+    SEARCH_BUDGET* budget_;             // Limits of the current search
 };
 
 #ifdef __cplusplus
@@ -11,6 +11,7 @@
 #define __SUDOKU_SHUFFLER_h__    1
 
 #include "element.h"
+#include "gridTransform.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,65 +23,47 @@ class sudokuShuffler{
 public:
 
     // Construction
-    sudokuShuffler(element* source);
+    //
+    //  @source : grid to shuffle
+    //  @random : generator of the random numbers
+    //
+    sudokuShuffler(GRID* source, randomGenerator* random);
 
     // Destruction
     ~sudokuShuffler(){}
 
+    // shuffle() : Apply a random transformation to the grid
+    //
+    //  Values, blocks of lines and columns, lines and columns in
+    //  each block are shuffled and the grid may be transposed,
+    //  in a single pass on the grid
+    //
+    void shuffle();
+
     // shuffleValues() : randomly shuffle elements' values
     //
     void shuffleValues();
 
-    // shuffleColumns() : randomly shuffle 2 columns in the same block
+    // shuffleColumns() : randomly shuffle the columns in each block
     //
     void shuffleColumns();
 
-    // shuffleColumnBlocks() : randomly shuffle 2 blocks of 3 columns
+    // shuffleColumnBlocks() : randomly shuffle the blocks of 3 columns
     //
     void shuffleColumnBlocks();
 
-    // shuffleRows() : randomly shuffle 2 rows in the same block
+    // shuffleRows() : randomly shuffle the rows in each block
     //
     void shuffleRows();
 
-    // shuffleRowBlocks() : randomly shuffle 2 blocks of 3 rows
+    // shuffleRowBlocks() : randomly shuffle the blocks of 3 rows
     //
     void shuffleRowBlocks();
 
-protected:
-
-    // _swapValues() : Swap 2 values in the whole grid
-    //
-    //  @first : value to replace by @second
-    //  @second : value to replace by @first
-    //
-    void _swapValues(uint8_t first, uint8_t second);
-
-    // _swapColumns() : Swap the elements of 2 columns
-    //
-    //  @fCol : col ID to swap with @sCol
-    //  @sCol : col ID to swap with @fcol
-    //
-    void _swapColumns(uint8_t fCol, uint8_t sCol);
-
-    // _swapColumnBlocks() : Swap blocks of 3 contiguous columns
-    //
-    void _swapColumnBlocks(uint8_t fColBlock, uint8_t sColBlock);
-
-    // _swapRows() : Swap the elements of 2 rows
-    //
-    //  @fRow : row ID to swap with @sRow
-    //  @sRow : row ID to swap with @fRow
-    //
-    void _swapRows(uint8_t fRow, uint8_t sRow);
-
-    // _swapRowBlocks() : Swap blocks of 3 contiguous rows
-    //
-    void _swapRowBlocks(uint8_t fRowBlock, uint8_t sRowBlock);
-
     // Members
 private:
-    element* elements_;
+    uint8_t* values_;   // Values of the grid
+    randomGenerator* random_;
 };
 
 #ifdef __cplusplus
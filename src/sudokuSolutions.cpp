@@ -0,0 +1,38 @@
+//----------------------------------------------------------------------
+//--
+//--    sudokuSolutions.cpp
+//--
+//--        Implementation of sudokuSolutions object
+//--        Lazy enumeration of the solutions of a sudoku
+//--
+//----------------------------------------------------------------------
+
+#include "sudokuSolutions.h"
+
+// Construction
+//
+//  @values : values of the grid (EMPTY_VALUE for empty elements)
+//
+sudokuSolutions::sudokuSolutions(const uint8_t* values)
+:engine_(SEARCH_MODE_PROPAGATE){
+    count_ = 0;
+    engine_.start(values);
+}
+
+// next() : Search for the next solution
+//
+//  @values : table that will receive the values of the solution.
+//          Can be NULL
+//
+//  @return : true if a new solution has been found
+//
+bool sudokuSolutions::next(uint8_t* values){
+    if (!engine_.next(values)){
+        return false;
+    }
+
+    count_++;
+    return true;
+}
+
+// EOF
@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------
+//--
+//--    sudokuSolutions.h
+//--
+//--        Definition of sudokuSolutions object
+//--        Lazy enumeration of the solutions of a sudoku
+//--
+//----------------------------------------------------------------------
+
+#ifndef __SUDOKU_SOLUTIONS_h__
+#define __SUDOKU_SOLUTIONS_h__    1
+
+#include "backtrackEngine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // #ifdef __cplusplus
+
+//   sudokuSolutions : Lazy enumeration of the solutions of a sudoku
+//
+//      Each call to next() resumes the search where it stopped.
+//      The search is done on a copy of the grid, kept in the object
+//      with the state of the search, so nothing is allocated and
+//      the grid is never modified
+//
+//      sudokuSolutions sols(game.solutions());
+//      uint8_t values[VALUES_COUNT];
+//      while (sols.next(values)){
+//          ...
+//      }
+//
+class sudokuSolutions{
+public:
+
+    // Construction
+    //
+    //  @values : values of the grid (EMPTY_VALUE for empty elements)
+    //
+    sudokuSolutions(const uint8_t* values);
+    sudokuSolutions(const sudokuSolutions&) = delete;
+
+    // Destruction
+    ~sudokuSolutions(){}
+
+    // next() : Search for the next solution
+    //
+    //  @values : table that will receive the values of the solution.
+    //          Can be NULL
+    //
+    //  @return : true if a new solution has been found
+    //
+    bool next(uint8_t* values = NULL);
+
+    // count() : # of solutions found so far
+    //
+    //  @return : # of solutions
+    //
+    uint32_t count(){
+        return count_;
+    }
+
+    // Members
+private:
+    backtrackEngine engine_;
+    uint32_t count_;
+};
+
+#ifdef __cplusplus
+}
+#endif // #ifdef __cplusplus
+
+#endif // __SUDOKU_SOLUTIONS_h__
+
+// EOF
@@ -53,29 +53,29 @@ bool tinySquare::setIndex(uint8_t index){
 //
 //   Check wether the value is already present in the current tiny-square
 //
-//  @elements : values
+//  @grid : values
 //  @value : value to check
 //
 //  @return true if found
 //
-bool tinySquare::inMe(element* elements, uint8_t value){
-    CPOINT pos = findValue(elements, value);
+bool tinySquare::inMe(const GRID* grid, uint8_t value){
+    CPOINT pos = findValue(grid, value);
     return (pos.line >=0 && pos.row>=0);
 }
 
 // findValue() : Search for the position of the value "in" the square
 //
-//  @elements : Game matrix
+//  @grid : Game matrix
 //  @value : value to search for
 //  @where : pointer to the position of the value (can be NULL)
 //
 //   @return : a CPOINT struct {line, row} if valid or {-1, -1} if not found
 //
-CPOINT tinySquare::findValue(element* elements, uint8_t value, position* where){
+CPOINT tinySquare::findValue(const GRID* grid, uint8_t value, position* where){
     // Check all the positions
     for (uint8_t line = 0; line < TINY_LINE_COUNT; line++){
         for (uint8_t row = 0; row < TINY_ROW_COUNT; row++){
-            if (value == elements[ids_[line][row]].value()){
+            if (value == grid->values[ids_[line][row]]){
                 // This value is in the square
                 if (where){
                     where->moveTo(line, row);
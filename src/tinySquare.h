@@ -76,24 +76,24 @@ public:
 
     // findValue() : Search for the position of the value "in" the square
     //
-    //  @elements : Game matrix
+    //  @grid : Game matrix
     //  @value : value to search for
     //  @where : pointer to the position of the value (can be NULL)
     //
     //   @return : a CPOINT struct {line, row} if valid or {-1, -1} if not found
     //
-    CPOINT findValue(element* elements, uint8_t value, position* where = NULL);
+    CPOINT findValue(const GRID* grid, uint8_t value, position* where = NULL);
 
      // inMe() : Is the given value "in" the square ?
     //
     //   Check wether the value is already present in the current tiny-square
     //
-    //  @elements : values
+    //  @grid : values
     //  @value : value to check
     //
     //  @return true if found
     //
-    bool inMe(element* elements, uint8_t value);
+    bool inMe(const GRID* grid, uint8_t value);
 
 private:
 